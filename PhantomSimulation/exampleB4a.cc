@@ -28,27 +28,65 @@
 /// \brief Main program of the B4a example
 
 #include "DetectorConstruction.hh"
+#include "ImportanceWorldConstruction.hh"
+#include "NeutronImagingPhysicsList.hh"
+#include "PhysicsTableCache.hh"
+#include "ScoringWorldConstruction.hh"
 #include "ActionInitialization.hh"
+#include "StartupMonitor.hh"
 
 #include "G4RunManagerFactory.hh"
+#include "G4ScoringManager.hh"
 #include "G4SteppingVerbose.hh"
 #include "G4UIcommand.hh"
 #include "G4UImanager.hh"
 #include "G4UIExecutive.hh"
 #include "G4VisExecutive.hh"
-#include "FTFP_BERT.hh"
+#include "G4PhysListFactory.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4GeometrySampler.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
 #include "Randomize.hh"
 
+#include <cstdlib>
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 namespace {
   void PrintUsage() {
     G4cerr << " Usage: " << G4endl;
     G4cerr << " exampleB4a [-m macro ] [-u UIsession] [-t nThreads] [-vDefault]"
-           << G4endl;
+           << " [-b] [-s] [-p physicsList]" << G4endl;
+    G4cerr << "   -b: geometry importance biasing of neutrons"
+           << " (see /phantom/biasing/ commands)" << G4endl;
+    G4cerr << "       the detector spectra and ntuple are then not booked,"
+           << " only their means are printed" << G4endl;
+    G4cerr << "   -s: parallel scoring world (see /phantom/scoring/ commands)"
+           << " and scoring meshes (see /score/ commands)" << G4endl;
+    G4cerr << "   -p: physics list, a reference list (eg. FTFP_BERT_HP,"
+           << " QGSP_BIC_HP) or NeutronImaging;" << G4endl;
+    G4cerr << "       the default is $PHYSLIST, or FTFP_BERT" << G4endl;
     G4cerr << "   note: -t option is available only for multi-threaded mode."
            << G4endl;
   }
+
+  /// Create the physics list of the given name: the lean neutron imaging
+  /// list, or any reference list known to the factory, with its
+  /// _HP and EM option variants
+  G4VModularPhysicsList* CreatePhysicsList(const G4String& name) {
+    if ( name == "NeutronImaging" ) {
+      return new B4::NeutronImagingPhysicsList();
+    }
+    G4PhysListFactory factory;
+    if ( ! factory.IsReferencePhysList(name) ) {
+      G4cerr << " Unknown physics list " << name << ", available lists:"
+             << " NeutronImaging and" << G4endl;
+      factory.AvailablePhysLists();
+      return nullptr;
+    }
+    return factory.GetReferencePhysList(name);
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -57,7 +95,7 @@ int main(int argc,char** argv)
 {
   // Evaluate arguments
   //
-  if ( argc > 7 ) {
+  if ( argc > 12 ) {
     PrintUsage();
     return 1;
   }
@@ -65,12 +103,19 @@ int main(int argc,char** argv)
   G4String macro;
   G4String session;
   G4bool verboseBestUnits = true;
+  G4bool importanceBiasing = false;
+  G4bool scoringWorld = false;
+  G4String physicsListName = "FTFP_BERT";
+  if ( auto physListEnv = std::getenv("PHYSLIST") ) {
+    physicsListName = physListEnv;
+  }
 #ifdef G4MULTITHREADED
   G4int nThreads = 0;
 #endif
   for ( G4int i=1; i<argc; i=i+2 ) {
     if      ( G4String(argv[i]) == "-m" ) macro = argv[i+1];
     else if ( G4String(argv[i]) == "-u" ) session = argv[i+1];
+    else if ( G4String(argv[i]) == "-p" ) physicsListName = argv[i+1];
 #ifdef G4MULTITHREADED
     else if ( G4String(argv[i]) == "-t" ) {
       nThreads = G4UIcommand::ConvertToInt(argv[i+1]);
@@ -80,12 +125,23 @@ int main(int argc,char** argv)
       verboseBestUnits = false;
       --i;  // this option is not followed with a parameter
     }
+    else if ( G4String(argv[i]) == "-b" ) {
+      importanceBiasing = true;
+      --i;  // this option is not followed with a parameter
+    }
+    else if ( G4String(argv[i]) == "-s" ) {
+      scoringWorld = true;
+      --i;  // this option is not followed with a parameter
+    }
     else {
       PrintUsage();
       return 1;
     }
   }
 
+  // Start measuring the startup time and memory of the physics list
+  B4::StartupMonitor::Instance()->Start(physicsListName);
+
   // Detect interactive mode (if no macro provided) and define UI session
   //
   G4UIExecutive* ui = nullptr;
@@ -112,15 +168,71 @@ int main(int argc,char** argv)
   }
 #endif
 
+  // Retrieve the physics tables from the local cache, or store them there
+  // (see /phantom/physicsCache/ commands); it follows the master states
+  B4::PhysicsTableCache::Instance();
+
+  // Activate the command based scoring meshes, each of them being
+  // a parallel world of its own
+  if ( scoringWorld ) {
+    G4ScoringManager::GetScoringManager();
+  }
+
   // Set mandatory initialization classes
   //
-  auto detConstruction = new B4::DetectorConstruction();
+  // the bound hydrogen of the phantoms is used only with the
+  // NeutronImaging list, the only one with thermal neutron scattering
+  auto detConstruction
+    = new B4::DetectorConstruction(physicsListName == "NeutronImaging");
+
+  // Optional importance cells, defined in a parallel world
+  const G4String importanceWorldName = "ImportanceWorld";
+  if ( importanceBiasing ) {
+    detConstruction->RegisterParallelWorld(
+      new B4::ImportanceWorldConstruction(importanceWorldName, detConstruction));
+  }
+
+  // Optional tally planes and ROI boxes, defined in a parallel world
+  // so that the mass geometry and its navigation are unchanged
+  const G4String scoringWorldName = "ScoringWorld";
+  if ( scoringWorld ) {
+    detConstruction->RegisterParallelWorld(
+      new B4::ScoringWorldConstruction(scoringWorldName));
+  }
   runManager->SetUserInitialization(detConstruction);
 
-  auto physicsList = new FTFP_BERT;
+  // The physics list is selected on the command line, as it must be
+  // given to the run manager before any macro is executed
+  auto physicsList = CreatePhysicsList(physicsListName);
+  if ( ! physicsList ) {
+    delete runManager;
+    delete ui;
+    return 1;
+  }
+  // G4UserSpecialCuts applies the user limits of the regions
+  // to all particles, neutrons included
+  auto stepLimiterPhysics = new G4StepLimiterPhysics();
+  stepLimiterPhysics->SetApplyToAll(true);
+  physicsList->RegisterPhysics(stepLimiterPhysics);
+
+  // Importance sampling of neutrons in the parallel world cells;
+  // the sampler world is set when the processes are constructed
+  G4GeometrySampler* geometrySampler = nullptr;
+  if ( importanceBiasing ) {
+    geometrySampler = new G4GeometrySampler(nullptr, "neutron");
+    geometrySampler->SetParallel(true);
+    physicsList->RegisterPhysics(
+      new G4ImportanceBiasing(geometrySampler, importanceWorldName));
+    physicsList->RegisterPhysics(new G4ParallelWorldPhysics(importanceWorldName));
+  }
+
+  // Transportation in the scoring world, for scoring only (no layered mass)
+  if ( scoringWorld ) {
+    physicsList->RegisterPhysics(new G4ParallelWorldPhysics(scoringWorldName));
+  }
   runManager->SetUserInitialization(physicsList);
 
-  auto actionInitialization = new B4a::ActionInitialization(detConstruction);
+  auto actionInitialization = new B4a::ActionInitialization(importanceBiasing);
   runManager->SetUserInitialization(actionInitialization);
 
   // Initialize visualization
@@ -157,6 +269,7 @@ int main(int argc,char** argv)
 
   delete visManager;
   delete runManager;
+  delete geometrySampler;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo.....
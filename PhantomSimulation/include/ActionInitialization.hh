@@ -32,12 +32,6 @@
 
 #include "G4VUserActionInitialization.hh"
 
-
-namespace B4
-{
-  class DetectorConstruction;
-}
-
 namespace B4a
 {
 
@@ -46,14 +40,16 @@ namespace B4a
 class ActionInitialization : public G4VUserActionInitialization
 {
   public:
-    ActionInitialization(B4::DetectorConstruction*);
+    /// With importance biasing, the run action does not book the
+    /// detector spectra (see B4::RunAction)
+    explicit ActionInitialization(G4bool importanceBiasing = false);
     ~ActionInitialization() override = default;
 
     void BuildForMaster() const override;
     void Build() const override;
 
   private:
-    B4::DetectorConstruction* fDetConstruction = nullptr;
+    G4bool fImportanceBiasing = false;
 };
 
 }
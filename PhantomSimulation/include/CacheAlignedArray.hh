@@ -0,0 +1,136 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/CacheAlignedArray.hh
+/// \brief Definition of the B4::CacheAlignedArray class template
+
+#ifndef B4CacheAlignedArray_h
+#define B4CacheAlignedArray_h 1
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+namespace B4
+{
+
+/// A flat, fixed size array of accumulators whose storage starts
+/// on a cache line boundary.
+///
+/// It is used as the storage of the scoring accumulables; Add() is the
+/// element-wise reduction used when merging the worker accumulables
+/// and is written so that the compiler can vectorise it.
+
+template <typename T>
+class CacheAlignedArray
+{
+  public:
+    static constexpr std::size_t kAlignment = 64;
+
+    CacheAlignedArray() = default;
+    explicit CacheAlignedArray(std::size_t size) { Resize(size); }
+    ~CacheAlignedArray() { Free(); }
+
+    CacheAlignedArray(const CacheAlignedArray&) = delete;
+    CacheAlignedArray& operator=(const CacheAlignedArray&) = delete;
+
+    /// Reallocate the array with the given size; the content is zeroed
+    void Resize(std::size_t size);
+    /// Set all elements to zero
+    void Zero();
+    /// Add the other array element by element; the sizes must match
+    void Add(const CacheAlignedArray& other);
+
+    T& operator[](std::size_t i) { return fData[i]; }
+    const T& operator[](std::size_t i) const { return fData[i]; }
+
+    T* Data() { return fData; }
+    const T* Data() const { return fData; }
+    std::size_t Size() const { return fSize; }
+
+  private:
+    void Free();
+
+    T* fData = nullptr;
+    std::size_t fSize = 0;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename T>
+inline void CacheAlignedArray<T>::Resize(std::size_t size)
+{
+  if ( size != fSize ) {
+    Free();
+    if ( size > 0 ) {
+      fData = static_cast<T*>(
+        ::operator new(size * sizeof(T), std::align_val_t(kAlignment)));
+      fSize = size;
+    }
+  }
+  Zero();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename T>
+inline void CacheAlignedArray<T>::Zero()
+{
+  std::fill(fData, fData + fSize, T(0));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename T>
+inline void CacheAlignedArray<T>::Add(const CacheAlignedArray& other)
+{
+  // Plain loop over non-aliasing contiguous storage:
+  // vectorised by the compiler
+  T* __restrict dst = fData;
+  const T* __restrict src = other.fData;
+  const auto size = std::min(fSize, other.fSize);
+  for ( std::size_t i = 0; i < size; ++i ) {
+    dst[i] += src[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename T>
+inline void CacheAlignedArray<T>::Free()
+{
+  if ( fData ) {
+    ::operator delete(fData, std::align_val_t(kAlignment));
+  }
+  fData = nullptr;
+  fSize = 0;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -31,28 +31,145 @@
 #define B4DetectorConstruction_h 1
 
 #include "G4VUserDetectorConstruction.hh"
+#include "OverlapCache.hh"
+#include "G4ThreeVector.hh"
+#include "G4TwoVector.hh"
 #include "globals.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
 
 class G4VPhysicalVolume;
+class G4LogicalVolume;
+class G4Material;
+class G4VSolid;
+class G4UserLimits;
 class G4GlobalMagFieldMessenger;
 
 namespace B4
 {
 
+class DetectorMessenger;
+class StlMesh;
+class VoxelPhantom;
+
 /// Detector construction class to define materials and geometry.
 /// In addition a transverse uniform magnetic field is defined
 /// via G4GlobalMagFieldMessenger class.
+///
+/// With thermalHydrogen (the NeutronImaging physics list, see
+/// exampleB4a), the hydrogen of the PLA and of the polyethylene is the
+/// "TS_H_of_Polyethylene" element, so that the thermal scattering of
+/// that list applies its bound hydrogen data (an approximation for the
+/// PLA). With the other lists, which have no thermal scattering, the
+/// plain NIST hydrogen is kept and the materials are unchanged.
+///
+/// The lead plate, the two phantoms and the detector are placed
+/// in the "Lead", "Phantoms" and "Detector" regions, each with its own
+/// production cuts and G4UserLimits (minimum kinetic energy, maximum
+/// track time), which can be set via /phantom/region/ commands.
+///
+/// Optional kill zones, vacuum boxes or planes defined via /phantom/killzone/
+/// commands, are placed in the world; neutrons crossing them which can
+/// no longer reach any of the volumes above are killed (see B4a::KillZoneSD).
+///
+/// For the two stage phase space mode, the moderator, collimator and
+/// polyethylene shielding can be added via /phantom/geometry/moderator,
+/// and a thin vacuum phase space plane, where the neutrons are recorded
+/// (see B4a::PhaseSpaceSD), via /phantom/geometry/phaseSpacePlane.
+///
+/// The main dimensions (lead thickness and cutout, phantom hole radii,
+/// teflon slot sizes and detector distance) are set via /phantom/geometry/
+/// commands. Between runs, the geometry is then rebuilt in the same process
+/// with G4RunManager::ReinitializeGeometry(), which also rebuilds the
+/// parallel worlds; ConstructSDandField() reuses the sensitive detectors,
+/// so that a geometry sweep does not reload the physics tables.
+///
+/// The phantom holes and the lead cutout are either subtracted from the
+/// volumes with G4SubtractionSolid (boolean, default) or placed in them as
+/// daughter volumes of the world material (daughters), which the navigator
+/// handles with its smart voxels; the representation is selected via
+/// /phantom/geometry/holes.
+///
+/// The PLA or the teflon phantom can be replaced by a G4TessellatedSolid
+/// imported from a binary STL file (see StlMesh), of the same material,
+/// via /phantom/geometry/stlPhantom; the maximum number of facet voxels
+/// of the solids is set via /phantom/geometry/stlMaxVoxels. The import
+/// costs (times, voxels, memory) are printed when the solid is built.
+///
+/// The overlaps are checked at each placement (always), never, or once the
+/// geometry is built, only if the same geometry was not validated before
+/// (cached, default; see OverlapCache), via /phantom/geometry/overlapCheck.
+///
+/// A voxelised phantom (see VoxelPhantom) can be loaded via
+/// /phantom/geometry/voxelPhantom; it replaces the PLA and teflon phantoms,
+/// against the back face of the lead, and the detector distance is then
+/// measured from its center. The voxels are placed with
+/// G4PhantomParameterisation and navigated with G4RegularNavigation,
+/// which skips the boundaries between voxels of the same material.
+///
+/// The NaI detector can be pixelated via /phantom/geometry/detectorPixels:
+/// it is then filled with columns replicated along x (G4PVReplica), each
+/// of them filled with pixels replicated along y, and the pixels are the
+/// sensitive volumes (see B4a::DetectorSD).
+///
+/// The smart voxel settings (smartless, optimisation) of any logical
+/// volume are set by name via /phantom/navigation/ commands; they are
+/// kept and applied again to each new geometry. The navigation times
+/// per volume are measured with a NavigationBenchmark, via
+/// /phantom/navigation/benchmark.
 
 class DetectorConstruction : public G4VUserDetectorConstruction
 {
   public:
-    DetectorConstruction() = default;
-    ~DetectorConstruction() override = default;
+    enum class HoleMode { kBoolean, kDaughters };
+    enum class OverlapCheckMode { kAlways, kCached, kNever };
+
+    explicit DetectorConstruction(G4bool thermalHydrogen = false);
+    ~DetectorConstruction() override;
 
   public:
     G4VPhysicalVolume* Construct() override;
     void ConstructSDandField() override;
 
+    // set methods
+    //
+    void SetRegionCut(const G4String& regionName, G4double cut);
+    void SetRegionMinKineticEnergy(const G4String& regionName, G4double ekin);
+    void SetRegionMaxTime(const G4String& regionName, G4double time);
+
+    /// Add a box kill zone; return false if the name is already used
+    G4bool AddKillBox(const G4String& name, const G4ThreeVector& center,
+                      const G4ThreeVector& halfSize);
+    void AddKillPlane(const G4String& name, G4double z);
+    void ClearKillZones();
+    void SetModeratorEnabled(G4bool value);
+    void SetPhaseSpacePlane(G4double z);
+    void SetHoleMode(const G4String& mode);
+    void SetOverlapCheckMode(const G4String& mode);
+    void SetOverlapCacheFile(const G4String& fileName);
+    void SetVoxelPhantom(const G4String& fileName);
+    void SetStlPhantom(const G4String& phantom, const G4String& fileName,
+                       G4double unit);
+    void SetStlMaxVoxels(G4int maxVoxels);
+    void SetLeadHalfThickness(G4double halfThickness);
+    void SetLeadCutout(G4double halfX, G4double halfY);
+    void SetHoleRadius(G4int hole, G4double radius);
+    void SetSlotHalfSize(G4int slot, G4double halfX, G4double halfY);
+    void SetDetectorDistance(G4double distance);
+    void SetDetectorPixels(G4int nx, G4int ny);
+    void SetVolumeSmartless(const G4String& volumeName, G4double smartless);
+    void SetVolumeOptimisation(const G4String& volumeName, G4bool optimise);
+
+    /// Fire the rays of a NavigationBenchmark across the current geometry
+    void RunNavigationBenchmark(G4int nofRays, G4double coneHalfAngle) const;
+
+    /// The names of the regions, separated by spaces
+    static G4String GetRegionNames();
+
     // get methods
     //
     const G4VPhysicalVolume* GetDetectorPhys() const; 
@@ -67,6 +184,24 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     //
     void DefineMaterials();
     G4VPhysicalVolume* DefineVolumes();
+    void DefineRegion(const G4String& regionName,
+                      const std::vector<G4LogicalVolume*>& volumes);
+    void UpdateRegion(const G4String& regionName);
+    void ComputeTargetBox(const G4LogicalVolume* worldLog);
+    void PlaceKillZones(G4LogicalVolume* worldLog, const G4ThreeVector& worldHalfSize);
+    void PlacePhaseSpacePlane(G4LogicalVolume* worldLog,
+                              const G4ThreeVector& worldHalfSize);
+    G4VSolid* BuildStlSolid(const G4String& name, const StlMesh& mesh,
+                            G4ThreeVector& position);
+    G4LogicalVolume* PlaceVoxelPhantom(G4LogicalVolume* worldLog,
+                                       G4double leadHalfZ);
+    void PlaceHole(G4VSolid* solid, G4LogicalVolume* motherLV,
+                   const G4ThreeVector& position, G4Material* material);
+    void GeometryHasChanged();
+    G4bool FitsInWorld(G4double leadHalfThickness,
+                       G4double detectorDistance) const;
+    G4int ApplyNavigationSettings() const;
+    void NavigationSettingsHaveChanged(const G4String& volumeName) const;
 
     // data members
     //
@@ -78,8 +213,86 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     G4VPhysicalVolume* fphysPhantom = nullptr;
     G4VPhysicalVolume* fphysPhantom4 = nullptr;
 
+    /// Production cut and user limits of a region;
+    /// a negative cut means the default production cut
+    struct RegionSettings {
+      G4double fCut = -1.;
+      G4double fMinKineticEnergy = 0.;
+      G4double fMaxTime = DBL_MAX;
+      G4UserLimits* fUserLimits = nullptr;
+    };
+    std::map<G4String, RegionSettings> fRegionSettings;
+
+    /// A kill zone box; a plane spans the whole world in x and y
+    struct KillZone {
+      G4String fName;
+      G4ThreeVector fCenter;
+      G4ThreeVector fHalfSize;
+      G4bool fIsPlane = false;
+    };
+    std::vector<KillZone> fKillZones;
+    std::vector<G4LogicalVolume*> fKillZoneLVs;
+
+    /// Bounding box of the volumes placed in the world
+    G4ThreeVector fTargetMin;
+    G4ThreeVector fTargetMax;
+
+    G4bool fThermalHydrogen = false;
+    G4bool fModeratorEnabled = false;
+    G4bool fPhaseSpacePlaneEnabled = false;
+    G4double fPhaseSpacePlaneZ = 0.;
+    G4LogicalVolume* fPhaseSpacePlaneLV = nullptr;
+
+    // fixed dimensions, used to check the geometry parameters
+    static constexpr G4double kWorldHalfSize = 0.5 * CLHEP::m;
+    static constexpr G4double kLeadHalfXY = 6. * CLHEP::cm;
+    static constexpr G4double kPhantomHalfX = 1.5 * CLHEP::cm;
+    static constexpr G4double kPhantomHalfY = 3. * CLHEP::cm;
+    static constexpr G4double kPhantomHalfZ = 0.75 * CLHEP::cm;
+    static constexpr G4double kDetectorHalfXY = 6. * CLHEP::cm;
+    static constexpr G4double kDetectorHalfZ = 10. * CLHEP::cm;
+    /// offsets of the outer PLA holes and teflon slots from the centre,
+    /// i.e. the pitch of the holes and of the slots
+    static constexpr G4double kHoleOffsetY = 17. * CLHEP::mm;
+    static constexpr G4double kSlotOffsetY = 15.5 * CLHEP::mm;
+
+    // geometry parameters, set via /phantom/geometry/ commands
+    HoleMode fHoleMode = HoleMode::kBoolean;
+    G4double fLeadHalfThickness = 1.25 * CLHEP::cm;
+    G4TwoVector fLeadCutoutHalfSize { 3. * CLHEP::cm, 2. * CLHEP::cm };
+    /// radii of the air holes in the PLA phantom, top to bottom
+    std::array<G4double, 3> fHoleRadii
+      = { 0.5 * CLHEP::cm, 0.25 * CLHEP::cm, 0.125 * CLHEP::cm };
+    /// half sizes of the air slots in the teflon phantom, top to bottom
+    std::array<G4TwoVector, 3> fSlotHalfSizes
+      = { G4TwoVector(0.5 * CLHEP::cm, 0.25 * CLHEP::cm),
+          G4TwoVector(0.25 * CLHEP::cm, 0.125 * CLHEP::cm),
+          G4TwoVector(0.125 * CLHEP::cm, 0.05 * CLHEP::cm) };
+    /// distance from the teflon phantom center to the detector center
+    G4double fDetectorDistance = 11. * CLHEP::cm;
+    /// numbers of detector pixels in x and y (0: single volume)
+    std::array<G4int, 2> fDetectorPixels = { 0, 0 };
+    /// the volume the detector sensitive detector is attached to
+    G4LogicalVolume* fDetectorSensitiveLV = nullptr;
+    /// voxelised phantom replacing the PLA and teflon phantoms, if any
+    std::unique_ptr<VoxelPhantom> fVoxelPhantom;
+    /// STL meshes replacing the PLA and the teflon phantoms, if any
+    std::array<std::unique_ptr<StlMesh>, 2> fStlMeshes;
+    /// maximum number of voxels of the STL solids (0: Geant4 default)
+    G4int fStlMaxVoxels = 0;
+
+    /// Smart voxel settings of a logical volume (Geant4 defaults)
+    struct NavigationSettings {
+      G4double fSmartless = 2.;
+      G4bool fOptimise = true;
+    };
+    std::map<G4String, NavigationSettings> fNavigationSettings;
+
+    DetectorMessenger* fMessenger = nullptr;
 
-    G4bool fCheckOverlaps = true; // option to activate checking of volumes overlaps
+    OverlapCheckMode fOverlapCheckMode = OverlapCheckMode::kCached;
+    OverlapCache fOverlapCache;
+    G4bool fCheckOverlaps = true; // check the overlaps at each placement (always mode)
 };
 
 // inline functions
@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/DetectorHit.hh
+/// \brief Definition of the B4a::DetectorHit class
+
+#ifndef B4aDetectorHit_h
+#define B4aDetectorHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+namespace B4a
+{
+
+/// Detector hit class
+///
+/// It defines data members to store the energy deposit and the neutron
+/// track length in the NaI detector, weighted with the track weights:
+/// - fEdep, fTrackLength
+
+class DetectorHit : public G4VHit
+{
+  public:
+    DetectorHit() = default;
+    DetectorHit(const DetectorHit&) = default;
+    ~DetectorHit() override = default;
+
+    // operators
+    DetectorHit& operator=(const DetectorHit&) = default;
+    G4bool operator==(const DetectorHit&) const;
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+
+    // methods from base class
+    void Draw()  override {}
+    void Print() override;
+
+    // methods to handle data
+    void Add(G4double de, G4double dl);
+
+    // get methods
+    G4double GetEdep() const;
+    G4double GetTrackLength() const;
+
+  private:
+    G4double fEdep = 0.;        ///< Energy deposit in the sensitive volume
+    G4double fTrackLength = 0.; ///< Neutron track length in the sensitive volume
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+using DetectorHitsCollection = G4THitsCollection<DetectorHit>;
+
+extern G4ThreadLocal G4Allocator<DetectorHit>* DetectorHitAllocator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void* DetectorHit::operator new(size_t)
+{
+  if (!DetectorHitAllocator) {
+    DetectorHitAllocator = new G4Allocator<DetectorHit>;
+  }
+  void *hit;
+  hit = (void *) DetectorHitAllocator->MallocSingle();
+  return hit;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void DetectorHit::operator delete(void *hit)
+{
+  if (!DetectorHitAllocator) {
+    DetectorHitAllocator = new G4Allocator<DetectorHit>;
+  }
+  DetectorHitAllocator->FreeSingle((DetectorHit*) hit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void DetectorHit::Add(G4double de, G4double dl) {
+  fEdep += de;
+  fTrackLength += dl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4double DetectorHit::GetEdep() const {
+  return fEdep;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4double DetectorHit::GetTrackLength() const {
+  return fTrackLength;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,158 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/DetectorMessenger.hh
+/// \brief Definition of the B4::DetectorMessenger class
+
+#ifndef B4DetectorMessenger_h
+#define B4DetectorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIcommand;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIdirectory;
+class G4UIparameter;
+
+namespace B4
+{
+
+class DetectorConstruction;
+
+/// Messenger class that defines the commands of DetectorConstruction:
+///
+/// - /phantom/region/setCut region value unit
+///   production cut of the region (Lead, Phantoms or Detector)
+/// - /phantom/region/setMinEkin region value unit
+///   minimum kinetic energy of tracks in the region (G4UserLimits)
+/// - /phantom/region/setMaxTime region value unit
+///   maximum global time of tracks in the region (G4UserLimits)
+/// - /phantom/killzone/addBox name x y z halfX halfY halfZ unit
+///   vacuum box kill zone at (x, y, z)
+/// - /phantom/killzone/addPlane name z unit
+///   1 mm thick vacuum kill zone spanning the world at z
+/// - /phantom/killzone/clear
+///   remove all kill zones
+/// - /phantom/geometry/moderator true|false
+///   add the moderator, collimator and polyethylene shielding
+/// - /phantom/geometry/phaseSpacePlane z unit
+///   add the phase space plane at z
+/// - /phantom/geometry/holes boolean|daughters
+///   representation of the phantom holes and the lead cutout
+/// - /phantom/geometry/overlapCheck always|cached|never
+///   when the volume overlaps are checked
+/// - /phantom/geometry/overlapCacheFile fileName
+///   file of the validated geometry hashes
+/// - /phantom/geometry/voxelPhantom fileName|none
+///   voxelised phantom replacing the PLA and teflon phantoms
+/// - /phantom/geometry/stlPhantom PLA|teflon fileName|none unit
+///   binary STL solid replacing the PLA or the teflon phantom
+/// - /phantom/geometry/stlMaxVoxels value
+///   maximum number of facet voxels of the STL solids
+/// - /phantom/geometry/leadHalfThickness value unit
+/// - /phantom/geometry/leadCutout halfX halfY unit
+/// - /phantom/geometry/holeRadius hole radius unit
+///   radius of the PLA phantom hole 0, 1 or 2
+/// - /phantom/geometry/slotHalfSize slot halfX halfY unit
+///   half sizes of the teflon phantom slot 0, 1 or 2
+/// - /phantom/geometry/detectorDistance value unit
+///   distance from the teflon phantom to the detector
+/// - /phantom/geometry/detectorPixels nx ny
+///   pixelated detector (0 0 for a single volume)
+/// - /phantom/navigation/smartless volume value
+///   smartless of the smart voxels of the logical volume
+/// - /phantom/navigation/optimise volume true|false
+///   whether the daughters of the logical volume are voxelised
+/// - /phantom/navigation/benchmark nofRays coneHalfAngle unit
+///   navigation times per volume (see NavigationBenchmark)
+///
+/// The kill zone and geometry commands are also available between runs;
+/// the geometry is then rebuilt at the next run.
+
+class DetectorMessenger : public G4UImessenger
+{
+  public:
+    DetectorMessenger(DetectorConstruction* detConstruction);
+    ~DetectorMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    // methods
+    G4UIcommand* CreateRegionCommand(const G4String& name,
+                                     const G4String& guidance,
+                                     const G4String& unitCategory,
+                                     const G4String& defaultUnit);
+    G4UIcmdWithADoubleAndUnit* CreateLengthCommand(const G4String& name,
+                                                   const G4String& guidance);
+    G4UIparameter* CreateUnitParameter(const G4String& unitCategory,
+                                       const G4String& defaultUnit) const;
+
+    // data members
+    DetectorConstruction* fDetConstruction = nullptr;
+
+    G4UIdirectory* fPhantomDirectory = nullptr;
+    G4UIdirectory* fRegionDirectory = nullptr;
+    G4UIcommand* fSetCutCmd = nullptr;
+    G4UIcommand* fSetMinEkinCmd = nullptr;
+    G4UIcommand* fSetMaxTimeCmd = nullptr;
+
+    G4UIdirectory* fKillZoneDirectory = nullptr;
+    G4UIcommand* fAddKillBoxCmd = nullptr;
+    G4UIcommand* fAddKillPlaneCmd = nullptr;
+    G4UIcommand* fClearKillZonesCmd = nullptr;
+
+    G4UIdirectory* fGeometryDirectory = nullptr;
+    G4UIcmdWithABool* fModeratorCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fPhaseSpacePlaneCmd = nullptr;
+    G4UIcmdWithAString* fHoleModeCmd = nullptr;
+    G4UIcmdWithAString* fOverlapCheckCmd = nullptr;
+    G4UIcmdWithAString* fOverlapCacheFileCmd = nullptr;
+    G4UIcmdWithAString* fVoxelPhantomCmd = nullptr;
+    G4UIcommand* fStlPhantomCmd = nullptr;
+    G4UIcmdWithAnInteger* fStlMaxVoxelsCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fLeadHalfThicknessCmd = nullptr;
+    G4UIcommand* fLeadCutoutCmd = nullptr;
+    G4UIcommand* fHoleRadiusCmd = nullptr;
+    G4UIcommand* fSlotHalfSizeCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fDetectorDistanceCmd = nullptr;
+    G4UIcommand* fDetectorPixelsCmd = nullptr;
+
+    G4UIdirectory* fNavigationDirectory = nullptr;
+    G4UIcommand* fSmartlessCmd = nullptr;
+    G4UIcommand* fOptimiseCmd = nullptr;
+    G4UIcommand* fBenchmarkCmd = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
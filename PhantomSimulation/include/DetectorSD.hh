@@ -0,0 +1,145 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/DetectorSD.hh
+/// \brief Definition of the B4a::DetectorSD class
+
+#ifndef B4aDetectorSD_h
+#define B4aDetectorSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+#include "DetectorHit.hh"
+
+#include "G4ThreeVector.hh"
+
+#include <vector>
+
+class G4Step;
+class G4StepPoint;
+class G4HCofThisEvent;
+class G4GenericMessenger;
+
+namespace B4
+{
+  class ImageAccumulable;
+  class ImageCubeAccumulable;
+  class PixelAccumulable;
+}
+
+namespace B4a
+{
+
+/// NaI detector sensitive detector class
+///
+/// In Initialize(), it creates one hit for the whole detector per primary
+/// of the event; the steps are accounted in the hit of the primary
+/// their track descends from (see TrackInformation).
+/// In ProcessHits(), which is called only for steps inside the NaI,
+/// the energy deposit of all particles and the track length of neutrons
+/// are accumulated in the hit, and the neutron position is filled
+/// in the thread local h2 image accumulable and, when it is enabled,
+/// in the (x, y, E) image cube (see B4::RunAction), at the source
+/// energy of the primary.
+/// With an energy scan, it is also filled in the h2 image of the energy
+/// bin of the primary (see B4::PrimaryInfo).
+/// All values are weighted with the statistical weight of the track,
+/// so that the scores stay unbiased when variance reduction is used.
+/// The values are accounted in EventAction from the hit collection.
+///
+/// The h2 imaging mode is selected via /phantom/image/ commands:
+/// - allSteps: the neutron position is filled on every step in the NaI
+///   (default, reproduces the earlier h2 results)
+/// - entry: each neutron is filled once, when it crosses into the NaI
+///   (the crossings between pixels are not entries); optionally the
+///   entry point is projected along the neutron direction onto the
+///   detector front face plane
+///
+/// When the detector is pixelated (see B4::DetectorConstruction), the
+/// energy deposits are also summed per primary and per pixel, the pixel
+/// index being given by the replica numbers of the step volume, and in
+/// EndOfEvent() the pixels whose physical (unweighted) energy is above
+/// the threshold set via /phantom/image/pixelThreshold are filled in the
+/// thread local B4::PixelAccumulable (pixel hits, energy and pulse height
+/// spectrum), with the mean weight of their deposits.
+
+class DetectorSD : public G4VSensitiveDetector
+{
+  public:
+    enum class ImagingMode { kAllSteps, kEntry };
+
+    DetectorSD(const G4String& name,
+               const G4String& hitsCollectionName);
+    ~DetectorSD() override;
+
+    // methods from base class
+    void   Initialize(G4HCofThisEvent* hitCollection) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+    void   EndOfEvent(G4HCofThisEvent* hitCollection) override;
+
+    // set methods
+    void SetImagingMode(const G4String& mode);
+    /// Set the detector segmentation; 0 pixels for a single volume
+    void SetPixelLayout(G4int nx, G4int ny, G4double halfX, G4double halfY);
+
+  private:
+    // methods
+    void DefineCommands();
+    G4bool IsDetectorEntry(const G4StepPoint* point) const;
+    G4ThreeVector ProjectToFrontFace(const G4StepPoint* point) const;
+    void FillImage(const G4ThreeVector& position, G4double energy,
+                   G4double weight, B4::ImageAccumulable* sliceImage);
+
+    // data members
+    DetectorHitsCollection* fHitsCollection = nullptr;
+    G4GenericMessenger* fMessenger = nullptr;
+    B4::ImageAccumulable* fImage = nullptr;
+    B4::ImageCubeAccumulable* fCube = nullptr;
+    std::vector<B4::ImageAccumulable*> fSliceImages;
+    std::vector<B4::ImageAccumulable*> fPrimarySliceImages; ///< per primary
+    std::vector<G4double> fPrimaryEnergies; ///< per primary
+    B4::PixelAccumulable* fPixels = nullptr;
+
+    // detector segmentation and pixel energies of the current event,
+    // per primary slot and pixel
+    G4int fNofPixelsX = 0;
+    G4int fNofPixelsY = 0;
+    G4double fDetectorHalfX = 0.;
+    G4double fDetectorHalfY = 0.;
+    std::vector<G4double> fPixelEnergies;
+    std::vector<G4double> fPixelWeightedEnergies;
+    std::vector<std::size_t> fHitPixels;
+    G4double fPixelThreshold = 0.;
+
+    ImagingMode fImagingMode = ImagingMode::kAllSteps;
+    G4bool fProjectToFrontFace = false;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
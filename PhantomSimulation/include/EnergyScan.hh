@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/EnergyScan.hh
+/// \brief Definition of the B4::EnergyScan class
+
+#ifndef B4EnergyScan_h
+#define B4EnergyScan_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class G4GenericMessenger;
+
+namespace B4
+{
+
+/// Energy scan settings, shared by all threads
+///
+/// With an energy scan, one run samples the primary energies over
+/// a list of energies (/phantom/scan/energies) or over log spaced energy
+/// bins (/phantom/scan/logBins), the energy being then log uniform in
+/// the bin. Each primary is tagged with its energy bin (see PrimaryInfo)
+/// and the detector histograms and the h2 image are filled per energy
+/// slice, in addition to the totals (see RunAction).
+///
+/// The bins are selected round robin on the primary index (the default),
+/// which spreads each energy evenly over the run and the worker threads,
+/// or at random. The settings are changed via /phantom/scan/ commands
+/// on the master, between runs, and only read by the threads during
+/// the run.
+
+class EnergyScan
+{
+  public:
+    enum class Sampling { kRoundRobin, kRandom };
+
+    static EnergyScan* Instance();
+
+    // set methods
+    void SetEnergies(const G4String& energies);
+    void SetLogBins(const G4String& bins);
+    void SetSampling(const G4String& sampling);
+    void Clear();
+
+    /// Select the energy bin of the primary of the given index in the run
+    G4int SelectBin(G4long primaryIndex) const;
+    /// Sample the energy in the given bin
+    G4double SampleEnergy(G4int bin) const;
+
+    // get methods
+    G4bool IsActive() const;
+    G4int GetNofBins() const;
+    G4String GetBinLabel(G4int bin) const;
+
+  private:
+    EnergyScan();
+    ~EnergyScan();
+
+    void DefineCommands();
+
+    /// the list energies, or the log bin edges
+    std::vector<G4double> fEnergies;
+    G4bool fLogBins = false;
+    Sampling fSampling = Sampling::kRoundRobin;
+    G4GenericMessenger* fMessenger = nullptr;
+};
+
+// inline functions
+
+inline G4bool EnergyScan::IsActive() const {
+  return ! fEnergies.empty();
+}
+
+inline G4int EnergyScan::GetNofBins() const {
+  if ( fEnergies.empty() ) return 0;
+  return static_cast<G4int>(fLogBins ? fEnergies.size() - 1 : fEnergies.size());
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,124 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/EnergySpectrum.hh
+/// \brief Definition of the B4::EnergySpectrum class
+
+#ifndef B4EnergySpectrum_h
+#define B4EnergySpectrum_h 1
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace B4
+{
+
+/// Tabulated energy spectrum with alias table sampling
+///
+/// The spectrum is a histogram of energy bins [Elo, Ehi) with weights.
+/// An alias table (Walker/Vose) is built once when the spectrum is set,
+/// so that Sample() costs two random numbers and a few operations
+/// whatever the number of bins; the energy is uniform within the bin.
+///
+/// The spectrum is read from a file by Load(), in one of two formats:
+/// - text: one bin per line "Elo Ehi weight", energies in MeV;
+///   empty lines and lines starting with '#' are ignored
+/// - binary: char[8] "B4SPEC01", int32 nbins,
+///   then nbins x double[3] (Elo [MeV], Ehi [MeV], weight)
+///
+/// SetWatt() tabulates a Watt fission spectrum, as for Cf-252.
+
+class EnergySpectrum
+{
+  public:
+    EnergySpectrum() = default;
+    ~EnergySpectrum() = default;
+
+    /// Load the spectrum from a text or binary file; on failure a warning
+    /// is issued and the spectrum is not changed
+    G4bool Load(const G4String& fileName);
+
+    /// Tabulate the Watt spectrum exp(-E/a) sinh(sqrt(b E))
+    /// in nbins bins between 0 and emax
+    void SetWatt(G4double a, G4double b, G4double emax, G4int nbins);
+
+    /// Sample an energy
+    G4double Sample() const;
+    /// Sample an energy from two uniform random numbers in [0, 1)
+    G4double Sample(G4double u1, G4double u2) const;
+
+    // get methods
+    G4bool IsEmpty() const;
+    std::size_t GetNbins() const;
+    G4double GetMeanEnergy() const;
+
+  private:
+    G4bool Set(std::vector<G4double>&& low, std::vector<G4double>&& high,
+               const std::vector<G4double>& weights, const G4String& source);
+
+    // bin edges
+    std::vector<G4double> fLow;
+    std::vector<G4double> fWidth;
+    // alias table
+    std::vector<G4double> fProbability;
+    std::vector<std::size_t> fAlias;
+
+    G4double fMeanEnergy = 0.;
+};
+
+// inline functions
+
+inline G4double EnergySpectrum::Sample(G4double u1, G4double u2) const
+{
+  // the integer part of u1 * nbins selects the column, the fractional
+  // part selects the bin or its alias
+  auto nbins = fLow.size();
+  auto u = u1 * nbins;
+  auto i = std::min(static_cast<std::size_t>(u), nbins - 1);
+  if ( u - i >= fProbability[i] ) i = fAlias[i];
+
+  return fLow[i] + u2 * fWidth[i];
+}
+
+inline G4bool EnergySpectrum::IsEmpty() const {
+  return fLow.empty();
+}
+
+inline std::size_t EnergySpectrum::GetNbins() const {
+  return fLow.size();
+}
+
+inline G4double EnergySpectrum::GetMeanEnergy() const {
+  return fMeanEnergy;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -31,43 +31,54 @@
 #define B4aEventAction_h 1
 
 #include "G4UserEventAction.hh"
+
+#include "DetectorHit.hh"
+
 #include "globals.hh"
 
+namespace B4
+{
+  class RunAction;
+}
+
 namespace B4a
 {
 
 /// Event action class
 ///
-/// It defines data members to hold the energy deposit and track lengths
-/// of charged particles in Absober and Gap layers:
+/// In EndOfEventAction(), it reads the energy deposit and the neutron
+/// track length in the NaI detector of each primary from the DetectorSD
+/// hits collection, which has one hit per primary vertex, and fills the
+/// histograms and one ntuple row per primary.
+/// The hit values are weighted with the track weights; they are divided
+/// by the primary vertex weight and filled with this weight, which is
+/// also saved in the ntuple "Weight" column, so that the histograms
+/// stay unbiased with the source direction biasing.
+/// The weighted totals are also accumulated in the run action; with
+/// importance biasing, only these are filled (see B4::RunAction).
+/// With an energy scan, the energy bin of the primary (see B4::PrimaryInfo)
+/// is saved in the ntuple and the values are also filled in the energy
+/// sliced histograms of the B4::RunAction.
 
 class EventAction : public G4UserEventAction
 {
   public:
-    EventAction() = default;
+    explicit EventAction(B4::RunAction* runAction);
     ~EventAction() override = default;
 
     void  BeginOfEventAction(const G4Event* event) override;
     void    EndOfEventAction(const G4Event* event) override;
 
-    void AddDetector(G4double de, G4double dl);
-
-
   private:
-    G4double  fEnergyDetector = 0.;
-    G4double  fTrackLDetector = 0.;
+    // methods
+    DetectorHitsCollection* GetHitsCollection(G4int hcID,
+                                              const G4Event* event) const;
 
+    // data members
+    B4::RunAction* fRunAction = nullptr;
+    G4int  fDetectorHCID = -1;
 };
 
-// inline functions
-inline void EventAction::AddDetector(G4double de, G4double dl) {
-    fEnergyDetector += de;
-    fTrackLDetector += dl;
-}
-
-
-
-
 }
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
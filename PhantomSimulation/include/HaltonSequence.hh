@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/HaltonSequence.hh
+/// \brief Definition of the B4::HaltonSequence class
+
+#ifndef B4HaltonSequence_h
+#define B4HaltonSequence_h 1
+
+#include "globals.hh"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace B4
+{
+
+/// Scrambled Halton low discrepancy sequence
+///
+/// The point of index i has the coordinates radical inverse of i in the
+/// first kMaxDims prime bases, with the digits of each dimension
+/// permuted by a random permutation (Braaten-Weller like scrambling).
+/// The permutations are drawn from the seed given to Scramble() with a
+/// portable generator, so that the same seed gives the same points on
+/// every platform and thread: a point depends only on its index, and
+/// the points can then be shared between threads by event ID.
+
+class HaltonSequence
+{
+  public:
+    static constexpr G4int kMaxDims = 8;
+
+    HaltonSequence();
+    ~HaltonSequence() = default;
+
+    /// Redraw the digit permutations from the seed
+    void Scramble(std::uint64_t seed);
+
+    /// The coordinate dim of the point index, in [0, 1)
+    G4double Sample(std::uint64_t index, G4int dim) const;
+
+  private:
+    static constexpr std::array<G4int, kMaxDims> kBases
+      = { 2, 3, 5, 7, 11, 13, 17, 19 };
+
+    std::array<std::vector<G4int>, kMaxDims> fPermutations;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
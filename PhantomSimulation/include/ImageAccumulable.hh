@@ -0,0 +1,119 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/ImageAccumulable.hh
+/// \brief Definition of the B4::ImageAccumulable class
+
+#ifndef B4ImageAccumulable_h
+#define B4ImageAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include "CacheAlignedArray.hh"
+
+namespace B4
+{
+
+/// Dense 2D radiograph accumulator
+///
+/// Flat, cache aligned per-thread arrays of the bin contents, of the
+/// sums of the squared weights and of the entries, with precomputed
+/// inverse bin widths, so that Fill() costs a couple of arithmetic
+/// operations and three adds.
+/// It is registered in the G4AccumulableManager: the worker images are
+/// summed into the master one with a vectorised reduction in
+/// RunAction::EndOfRunAction(), and the master image is then exported
+/// to the H2 histogram which is written to the analysis output file.
+
+class ImageAccumulable : public G4VAccumulable
+{
+  public:
+    ImageAccumulable(const G4String& name,
+                     G4int nbinsx, G4double xmin, G4double xmax,
+                     G4int nbinsy, G4double ymin, G4double ymax);
+    ~ImageAccumulable() override = default;
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    /// Add weight to the bin containing (x, y); out of range values
+    /// are ignored
+    void Fill(G4double x, G4double y, G4double weight = 1.);
+
+    /// Set the content, the sum of the squared weights and the entries
+    /// of each non empty bin in the H2 histogram with the given id
+    /// (booked with the same binning), so that its bin errors are the
+    /// statistical ones
+    void FillH2(G4int id) const;
+
+    // get methods
+    G4int GetNbinsX() const;
+    G4int GetNbinsY() const;
+    G4double GetSum() const;
+
+  private:
+    G4int fNbinsX = 0;
+    G4int fNbinsY = 0;
+    G4double fXmin = 0.;
+    G4double fYmin = 0.;
+    G4double fInvWidthX = 0.;
+    G4double fInvWidthY = 0.;
+    CacheAlignedArray<G4double> fData;
+    CacheAlignedArray<G4double> fSumW2;
+    CacheAlignedArray<G4double> fEntries;
+};
+
+// inline functions
+
+inline void ImageAccumulable::Fill(G4double x, G4double y, G4double weight)
+{
+  auto u = (x - fXmin) * fInvWidthX;
+  auto v = (y - fYmin) * fInvWidthY;
+
+  // written so that NaN values are rejected as well
+  if ( ! ( u >= 0. && u < fNbinsX && v >= 0. && v < fNbinsY ) ) return;
+
+  auto i = static_cast<std::size_t>(v) * fNbinsX + static_cast<std::size_t>(u);
+  fData[i] += weight;
+  fSumW2[i] += weight * weight;
+  fEntries[i] += 1.;
+}
+
+inline G4int ImageAccumulable::GetNbinsX() const {
+  return fNbinsX;
+}
+
+inline G4int ImageAccumulable::GetNbinsY() const {
+  return fNbinsY;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/ImageCubeAccumulable.hh
+/// \brief Definition of the B4::ImageCubeAccumulable class
+
+#ifndef B4ImageCubeAccumulable_h
+#define B4ImageCubeAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include "CacheAlignedArray.hh"
+
+#include <cmath>
+
+namespace B4
+{
+
+/// Energy resolved radiograph accumulator
+///
+/// A dense (x, y, E) cube of float bin contents with log spaced energy
+/// bins, so that a single broad spectrum run yields the image for every
+/// source energy slice (the kinetic energy of the primary). The layout is set with SetLayout() before each
+/// run; when no layout is set the cube holds no memory and is inactive.
+///
+/// It is merged like ImageAccumulable and written by the master with
+/// Write() in a binary file:
+/// - header: char[8] "B4CUBE01", int32 nx, ny, ne,
+///   double xmin, xmax, ymin, ymax [mm], emin, emax [MeV]
+/// - data: float[ne][ny][nx], each energy slice being one image
+
+class ImageCubeAccumulable : public G4VAccumulable
+{
+  public:
+    explicit ImageCubeAccumulable(const G4String& name);
+    ~ImageCubeAccumulable() override = default;
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    /// Allocate the cube for the given layout
+    /// (the same x and y binning, log spaced energy bins)
+    void SetLayout(G4int nbinsxy, G4double xymin, G4double xymax,
+                   G4int nbinse, G4double emin, G4double emax);
+    /// Release the cube memory; the cube becomes inactive
+    void Clear();
+
+    /// Add weight to the bin containing (x, y, energy); out of range
+    /// values are ignored
+    void Fill(G4double x, G4double y, G4double energy, G4double weight = 1.);
+
+    /// Write the cube in the binary format described above
+    G4bool Write(const G4String& fileName) const;
+
+    // get methods
+    G4bool IsActive() const;
+    std::size_t GetMemorySize() const;
+
+  private:
+    G4int fNbinsXY = 0;
+    G4int fNbinsE = 0;
+    G4double fXYmin = 0.;
+    G4double fXYmax = 0.;
+    G4double fEmin = 0.;
+    G4double fEmax = 0.;
+    G4double fLogEmin = 0.;
+    G4double fInvWidthXY = 0.;
+    G4double fInvLogWidthE = 0.;
+    CacheAlignedArray<G4float> fData;
+};
+
+// inline functions
+
+inline void ImageCubeAccumulable::Fill(G4double x, G4double y,
+                                       G4double energy, G4double weight)
+{
+  if ( ! ( energy > 0. ) ) return;
+
+  auto u = (x - fXYmin) * fInvWidthXY;
+  auto v = (y - fXYmin) * fInvWidthXY;
+  auto w = (std::log(energy) - fLogEmin) * fInvLogWidthE;
+
+  // written so that NaN values are rejected as well
+  if ( ! ( u >= 0. && u < fNbinsXY && v >= 0. && v < fNbinsXY &&
+           w >= 0. && w < fNbinsE ) ) return;
+
+  auto index
+    = ( static_cast<std::size_t>(w) * fNbinsXY + static_cast<std::size_t>(v) )
+      * fNbinsXY + static_cast<std::size_t>(u);
+  fData[index] += static_cast<G4float>(weight);
+}
+
+inline G4bool ImageCubeAccumulable::IsActive() const {
+  return fData.Size() > 0;
+}
+
+inline std::size_t ImageCubeAccumulable::GetMemorySize() const {
+  return fData.Size() * sizeof(G4float);
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,89 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/ImportanceWorldConstruction.hh
+/// \brief Definition of the B4::ImportanceWorldConstruction class
+
+#ifndef B4ImportanceWorldConstruction_h
+#define B4ImportanceWorldConstruction_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "globals.hh"
+
+#include <utility>
+#include <vector>
+
+class G4VPhysicalVolume;
+class G4GenericMessenger;
+
+namespace B4
+{
+
+class DetectorConstruction;
+
+/// Parallel world of the geometry importance biasing of neutrons.
+///
+/// The world is divided in slabs along z, spanning the world in x and y:
+/// one slab in front of the lead plate, fNofLeadSlices slabs inside it
+/// and one slab behind it. The importance is 1 in front of the lead and
+/// in its first slice, and it is multiplied by fImportanceRatio in each
+/// following slice and once more behind the lead, so that the neutrons
+/// are split as they go through the plate (and Russian roulette is
+/// played when they come back).
+///
+/// The layout is set via /phantom/biasing/ commands before the run
+/// initialization; the importance store is filled per thread in ConstructSD().
+/// The biasing is activated with the -b option of exampleB4a.
+
+class ImportanceWorldConstruction : public G4VUserParallelWorld
+{
+  public:
+    ImportanceWorldConstruction(const G4String& worldName,
+                                const DetectorConstruction* massWorld);
+    ~ImportanceWorldConstruction() override;
+
+    void Construct() override;
+    void ConstructSD() override;
+
+  private:
+    // methods
+    void DefineCommands();
+
+    // data members
+    const DetectorConstruction* fMassWorld = nullptr;
+    /// The importance cells with their importance values
+    std::vector<std::pair<const G4VPhysicalVolume*, G4double>> fCells;
+
+    G4int fNofLeadSlices = 4;
+    G4double fImportanceRatio = 2.;
+    G4GenericMessenger* fMessenger = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
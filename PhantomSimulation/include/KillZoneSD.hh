@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/KillZoneSD.hh
+/// \brief Definition of the B4a::KillZoneSD class
+
+#ifndef B4aKillZoneSD_h
+#define B4aKillZoneSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "G4ThreeVector.hh"
+
+class G4Step;
+
+namespace B4
+{
+  class TallyAccumulable;
+}
+
+namespace B4a
+{
+
+/// Kill zone sensitive detector class
+///
+/// It is attached to the kill zone volumes (see B4::DetectorConstruction).
+/// In ProcessHits(), a neutron is killed when its straight line path
+/// misses the target box, the bounding box of all the volumes placed
+/// in the world: as the world is vacuum, such a neutron cannot interact
+/// again and so it can no longer reach the detector.
+/// The killed histories are counted per kill zone in the "KillZones"
+/// tally accumulable and printed at the end of run.
+
+class KillZoneSD : public G4VSensitiveDetector
+{
+  public:
+    KillZoneSD(const G4String& name);
+    ~KillZoneSD() override = default;
+
+    // methods from base class
+    void   Initialize(G4HCofThisEvent* hitCollection) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+
+    // set methods
+    void SetTargetBox(const G4ThreeVector& pMin, const G4ThreeVector& pMax);
+
+  private:
+    // methods
+    G4bool CanReachTarget(const G4ThreeVector& position,
+                          const G4ThreeVector& direction) const;
+
+    // data members
+    G4ThreeVector fTargetMin;
+    G4ThreeVector fTargetMax;
+    B4::TallyAccumulable* fTally = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,82 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/NavigationBenchmark.hh
+/// \brief Definition of the B4::NavigationBenchmark class
+
+#ifndef B4NavigationBenchmark_h
+#define B4NavigationBenchmark_h 1
+
+#include "globals.hh"
+
+class G4VPhysicalVolume;
+
+namespace B4
+{
+
+/// Navigation micro-benchmark
+///
+/// A fixed set of straight rays, the tracks of geantinos without the
+/// tracking overhead, is fired across the mass geometry with a private
+/// G4Navigator. The ray origins are spread over a square of the given
+/// half size on the world front face, and their directions within a
+/// cone around +z, from the points of a HaltonSequence with a fixed
+/// seed, so that the same rays are fired at every call.
+///
+/// Each ray is followed up to the world boundary with ComputeStep() and
+/// LocateGlobalPointAndSetup(), as in the transportation. The time of
+/// each ComputeStep() call is accounted to the logical volume where the
+/// step is computed, and the time of each LocateGlobalPointAndSetup()
+/// call to the volume where the point is located.
+///
+/// Run() first rebuilds the smart voxels, so that they follow the current
+/// smartless and optimisation settings of the volumes, and then prints,
+/// per logical volume sorted by total time: the number of daughters, the
+/// voxel settings, and the number of calls and mean time of both methods.
+/// The times include the clock overhead, which is printed as well.
+
+class NavigationBenchmark
+{
+  public:
+    NavigationBenchmark(G4double beamHalfSize, G4double coneHalfAngle);
+    ~NavigationBenchmark() = default;
+
+    /// Fire the rays across the geometry below the world
+    /// and print the times per volume
+    void Run(G4VPhysicalVolume* world, G4int nofRays) const;
+
+  private:
+    static constexpr G4int kMaxStepsPerRay = 100000;
+
+    G4double fBeamHalfSize = 0.;
+    G4double fConeHalfAngle = 0.;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,66 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/NeutronHPPhysics.hh
+/// \brief Definition of the B4::NeutronHPPhysics class
+
+#ifndef B4NeutronHPPhysics_h
+#define B4NeutronHPPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+namespace B4
+{
+
+/// Neutron physics constructor with the data driven (HP) models only
+///
+/// It defines the neutron elastic, inelastic and capture processes with
+/// the G4ParticleHP models and cross sections, valid up to 20 MeV, and
+/// nothing else: no other hadron is given hadronic processes.
+/// Below 4 eV the elastic scattering uses G4ParticleHPThermalScattering,
+/// which applies the bound atom data to the "TS_" elements (the hydrogen
+/// of the PLA and of the polyethylene, see DetectorConstruction) and the
+/// free gas model to all the others. The _HP reference lists have no
+/// thermal scattering. The
+/// products of the reactions (recoil ions, protons, alphas, capture
+/// gammas) are transported by the electromagnetic physics.
+
+class NeutronHPPhysics : public G4VPhysicsConstructor
+{
+  public:
+    explicit NeutronHPPhysics(const G4String& name = "neutronHP");
+    ~NeutronHPPhysics() override = default;
+
+    void ConstructParticle() override;
+    void ConstructProcess() override;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
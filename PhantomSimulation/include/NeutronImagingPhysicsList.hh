@@ -0,0 +1,61 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/NeutronImagingPhysicsList.hh
+/// \brief Definition of the B4::NeutronImagingPhysicsList class
+
+#ifndef B4NeutronImagingPhysicsList_h
+#define B4NeutronImagingPhysicsList_h 1
+
+#include "G4VModularPhysicsList.hh"
+
+namespace B4
+{
+
+/// Lean modular physics list for neutron imaging (thermal - 2.5 MeV)
+///
+/// It keeps only what the outputs need: the neutron transport with the
+/// HP models, including the thermal scattering below 4 eV
+/// (see NeutronHPPhysics), which gives the neutron image and
+/// track length, and the standard electromagnetic physics, which gives
+/// the energy deposit of the reaction products in the NaI.
+/// There are no hadronic processes for the other particles, no decay
+/// and no radioactive decay.
+///
+/// It is selected with "-p NeutronImaging" (see exampleB4a).
+
+class NeutronImagingPhysicsList : public G4VModularPhysicsList
+{
+  public:
+    NeutronImagingPhysicsList();
+    ~NeutronImagingPhysicsList() override = default;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/OverlapCache.hh
+/// \brief Definition of the B4::OverlapCache class
+
+#ifndef B4OverlapCache_h
+#define B4OverlapCache_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+
+class G4VPhysicalVolume;
+
+namespace B4
+{
+
+/// Overlap validation with a cache of the results
+///
+/// The geometry description (volume names, copy numbers, positions,
+/// rotations, materials and the full solid parameters from StreamInfo(),
+/// of every volume below the world, and the Geant4 version) is hashed
+/// with the 64 bits FNV-1a hash, without building the description text.
+///
+/// Validate() looks the hash up in a local text cache file, with one
+/// "hash nofOverlaps" line per validated geometry; when it is not found,
+/// the overlaps of all placed volumes are checked and the result is
+/// appended to the file. Any change of the geometry thus forces a new
+/// check, while the processes of a sweep over the same geometries skip it.
+///
+/// The parameterised volumes (the voxels of the voxel phantom) are not
+/// checked: they fill their container by construction.
+
+class OverlapCache
+{
+  public:
+    OverlapCache() = default;
+    ~OverlapCache() = default;
+
+    /// Check the overlaps below the world, unless the result of the same
+    /// geometry is in the cache file; return the number of volumes
+    /// with overlaps
+    G4int Validate(const G4VPhysicalVolume* world);
+    /// Check the overlaps of all placed volumes below the world
+    static G4int CheckOverlaps(const G4VPhysicalVolume* world);
+    /// Hash of the geometry description below the world
+    static std::uint64_t ComputeHash(const G4VPhysicalVolume* world);
+
+    // set methods
+    void SetFileName(const G4String& fileName);
+
+  private:
+    G4bool Find(std::uint64_t hash, G4int& nofOverlaps) const;
+    void Store(std::uint64_t hash, G4int nofOverlaps) const;
+
+    G4String fFileName = "B4_overlaps.cache";
+};
+
+// inline functions
+
+inline void OverlapCache::SetFileName(const G4String& fileName) {
+  fFileName = fileName;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,64 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/PhaseSpaceFormat.hh
+/// \brief Definition of the B4 phase space file format
+
+#ifndef B4PhaseSpaceFormat_h
+#define B4PhaseSpaceFormat_h 1
+
+#include <cstddef>
+#include <cstdint>
+
+namespace B4
+{
+
+/// Phase space file format, written by PhaseSpaceWriter and read
+/// by PhaseSpaceReader:
+/// - header: char[8] "B4PHSP01", uint64 number of records
+/// - data: the records, 32 bytes each
+
+/// One particle crossing the phase space plane;
+/// the position is in mm and the energy in MeV
+struct PhaseSpaceRecord {
+  float fX, fY, fZ;
+  float fDirX, fDirY, fDirZ;
+  float fEnergy;
+  float fWeight;
+};
+
+static_assert(sizeof(PhaseSpaceRecord) == 32,
+              "PhaseSpaceRecord must be 32 bytes");
+
+constexpr char kPhaseSpaceMagic[8] = { 'B', '4', 'P', 'H', 'S', 'P', '0', '1' };
+constexpr std::size_t kPhaseSpaceHeaderSize
+  = sizeof(kPhaseSpaceMagic) + sizeof(std::uint64_t);
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,90 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/PhaseSpaceReader.hh
+/// \brief Definition of the B4::PhaseSpaceReader class
+
+#ifndef B4PhaseSpaceReader_h
+#define B4PhaseSpaceReader_h 1
+
+#include "PhaseSpaceFormat.hh"
+
+#include "globals.hh"
+
+namespace B4
+{
+
+/// Memory mapped phase space file reader
+///
+/// The file written by PhaseSpaceWriter is mapped read-only in memory
+/// (mmap on POSIX systems, a file mapping on Windows), so that the
+/// records are read in place, without copies, and the pages are shared
+/// by all the threads which open the same file.
+
+class PhaseSpaceReader
+{
+  public:
+    PhaseSpaceReader() = default;
+    ~PhaseSpaceReader();
+
+    PhaseSpaceReader(const PhaseSpaceReader&) = delete;
+    PhaseSpaceReader& operator=(const PhaseSpaceReader&) = delete;
+
+    /// Map the file; on failure a warning is issued and the reader is empty
+    G4bool Open(const G4String& fileName);
+    void Close();
+
+    // get methods
+    std::size_t GetNofRecords() const;
+    const PhaseSpaceRecord& GetRecord(std::size_t i) const;
+
+  private:
+    const PhaseSpaceRecord* fRecords = nullptr;
+    std::size_t fNofRecords = 0;
+
+    void* fMapping = nullptr;
+    std::size_t fMappingSize = 0;
+#ifdef _WIN32
+    void* fFileHandle = nullptr;
+    void* fMappingHandle = nullptr;
+#endif
+};
+
+// inline functions
+
+inline std::size_t PhaseSpaceReader::GetNofRecords() const {
+  return fNofRecords;
+}
+
+inline const PhaseSpaceRecord& PhaseSpaceReader::GetRecord(std::size_t i) const {
+  return fRecords[i];
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,62 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/PhaseSpaceSD.hh
+/// \brief Definition of the B4a::PhaseSpaceSD class
+
+#ifndef B4aPhaseSpaceSD_h
+#define B4aPhaseSpaceSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+class G4Step;
+
+namespace B4a
+{
+
+/// Phase space plane sensitive detector class
+///
+/// It is attached to the thin phase space plane volume
+/// (see B4::DetectorConstruction). In ProcessHits(), each neutron entering
+/// the plane in the forward (+z) direction is recorded with the
+/// B4::PhaseSpaceWriter, and then killed unless
+/// /phantom/phasespace/killRecorded is false.
+
+class PhaseSpaceSD : public G4VSensitiveDetector
+{
+  public:
+    PhaseSpaceSD(const G4String& name);
+    ~PhaseSpaceSD() override = default;
+
+    // methods from base class
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/PhaseSpaceWriter.hh
+/// \brief Definition of the B4::PhaseSpaceWriter class
+
+#ifndef B4PhaseSpaceWriter_h
+#define B4PhaseSpaceWriter_h 1
+
+#include "PhaseSpaceFormat.hh"
+
+#include "G4Threading.hh"
+#include "globals.hh"
+
+#include <fstream>
+#include <vector>
+
+namespace B4
+{
+
+/// Phase space file writer, shared by all threads
+///
+/// The master opens the file at the beginning of run and closes it at
+/// the end of run. The records are added to a thread local buffer,
+/// which is appended to the file under a mutex when it is full and
+/// when the thread calls Flush() at its end of run.
+
+class PhaseSpaceWriter
+{
+  public:
+    static PhaseSpaceWriter* Instance();
+
+    G4bool Open(const G4String& fileName);
+    void Close();
+
+    void Add(const PhaseSpaceRecord& record);
+    void Flush();
+
+    // set methods
+    void SetKillRecorded(G4bool value);
+
+    // get methods
+    G4bool IsOpen() const;
+    G4bool GetKillRecorded() const;
+
+  private:
+    PhaseSpaceWriter() = default;
+    ~PhaseSpaceWriter() = default;
+
+    static constexpr std::size_t kBufferSize = 4096;
+
+    std::vector<PhaseSpaceRecord>& GetBuffer();
+
+    std::ofstream fFile;
+    std::uint64_t fNofRecords = 0;
+    G4bool fIsOpen = false;
+    G4bool fKillRecorded = true;
+    G4Mutex fMutex = G4MUTEX_INITIALIZER;
+};
+
+// inline functions
+
+inline void PhaseSpaceWriter::SetKillRecorded(G4bool value) {
+  fKillRecorded = value;
+}
+
+inline G4bool PhaseSpaceWriter::IsOpen() const {
+  return fIsOpen;
+}
+
+inline G4bool PhaseSpaceWriter::GetKillRecorded() const {
+  return fKillRecorded;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,133 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/PhysicsTableCache.hh
+/// \brief Definition of the B4::PhysicsTableCache class
+
+#ifndef B4PhysicsTableCache_h
+#define B4PhysicsTableCache_h 1
+
+#include "G4Timer.hh"
+#include "G4VStateDependent.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <string>
+
+class G4GenericMessenger;
+
+namespace B4
+{
+
+/// Persistent cache of the physics tables, shared by the processes
+///
+/// The physics tables are stored in a local directory (/phantom/physicsCache/
+/// directory), with one entry per key. The key describes the physics list
+/// (its name, see StartupMonitor), the material table, the production cuts
+/// of the regions and their energy range, the EM parameters and the Geant4
+/// version; the entry name is the physics list name and the FNV-1a hash
+/// of the key, and the full key text is written in the entry once all
+/// the tables have been stored.
+///
+/// The key is evaluated on the master at the start of each run
+/// initialisation (Idle -> Init transition), before the tables are built:
+/// - when the entry exists with the same key text, the tables are
+///   retrieved from it (G4VUserPhysicsList::SetPhysicsTableRetrieved),
+/// - otherwise (no entry, or a different key text after a hash collision
+///   or an interrupted store) the tables are built, and stored at the
+///   beginning of the run (G4VUserPhysicsList::StorePhysicsTable).
+/// Geant4 checks in addition that the stored cuts table matches the
+/// material-cuts couples of the geometry and rebuilds the tables if not.
+///
+/// The entries are stored in a temporary directory which is then renamed,
+/// so that concurrent jobs never read a partial entry.
+/// The cache is owned by the state manager, which deletes it.
+
+class PhysicsTableCache : public G4VStateDependent
+{
+  public:
+    enum class Status { kNone, kDisabled, kBuilt, kRetrieved };
+
+    static PhysicsTableCache* Instance();
+
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+    /// Store the tables built for a new key and stop the timer;
+    /// to be called on the master at the beginning of the run
+    void BeginOfRun();
+    /// Print how the tables of the last initialisation were obtained,
+    /// with the run initialisation time, once per initialisation
+    void Print();
+
+    // set methods
+    void SetEnabled(G4bool enabled);
+    void SetDirectory(const G4String& directory);
+    void Clear();
+
+    /// The key text of the current physics list, materials and cuts
+    static std::string ComputeKey();
+
+  private:
+    PhysicsTableCache();
+    ~PhysicsTableCache() override;
+
+    void DefineCommands();
+    void SelectEntry();
+    G4String GetEntryName(const std::string& key) const;
+    void Store();
+
+    G4bool fEnabled = true;
+    G4String fDirectory = "B4_physics_tables";
+    G4GenericMessenger* fMessenger = nullptr;
+
+    G4ApplicationState fState = G4State_PreInit;
+    std::string fKey;
+    G4String fEntryName;
+    G4bool fStorePending = false;
+    G4bool fRetrieving = false;
+    Status fStatus = Status::kNone;
+    G4Timer fTimer;
+    G4bool fInitialising = false;
+    G4double fInitialisationTime = 0.;
+};
+
+// inline functions
+
+inline void PhysicsTableCache::SetEnabled(G4bool enabled) {
+  fEnabled = enabled;
+  fKey.clear();
+}
+
+inline void PhysicsTableCache::SetDirectory(const G4String& directory) {
+  fDirectory = directory;
+  fKey.clear();
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/PixelAccumulable.hh
+/// \brief Definition of the B4::PixelAccumulable class
+
+#ifndef B4PixelAccumulable_h
+#define B4PixelAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include "CacheAlignedArray.hh"
+
+namespace B4
+{
+
+/// Pixelated detector readout accumulator
+///
+/// For each pixel of the segmented NaI detector, it accumulates the
+/// weighted number of pixel hits (pixels above threshold for one
+/// primary), their weighted summed energy and their weighted pulse height
+/// spectrum, with linear energy bins from 0 to the maximum energy set
+/// with SetSpectrum(). The values are double, like in ImageAccumulable,
+/// so that long runs keep counting and summing small energies.
+/// The pixels are filled by their index (see B4a::DetectorSD), so no
+/// coordinate binning is involved.
+///
+/// The pixel layout follows the geometry: it is set by the sensitive
+/// detector with SetLayout() and is inactive (no memory) when the
+/// detector is not pixelated. The master adopts the layout of the
+/// worker accumulables in Merge().
+///
+/// It is written by the master with Write() in a binary file:
+/// - header: char[8] "B4PIXL02", int32 nx, ny, ne,
+///   double xmin, xmax, ymin, ymax [mm], emin, emax [MeV]
+/// - data: double counts[ny][nx], double energy[ny][nx] [MeV],
+///   double spectra[ny][nx][ne]
+/// with the same x orientation as the h2 image.
+
+class PixelAccumulable : public G4VAccumulable
+{
+  public:
+    explicit PixelAccumulable(const G4String& name);
+    ~PixelAccumulable() override = default;
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    /// Set the spectrum binning, applied at the next SetLayout()
+    void SetSpectrum(G4int nbinsE, G4double emax);
+    /// Allocate the pixels of a detector of the given half sizes
+    void SetLayout(G4int nx, G4int ny, G4double halfX, G4double halfY);
+    /// Release the memory; the accumulable becomes inactive
+    void Clear();
+
+    /// Add a hit of the given (physical) energy in the pixel, with the
+    /// given statistical weight; energies above the spectrum range are
+    /// counted but not binned
+    void Fill(std::size_t pixel, G4double energy, G4double weight = 1.);
+
+    /// Write the pixels in the binary format described above
+    G4bool Write(const G4String& fileName) const;
+
+    // get methods
+    G4bool IsActive() const;
+    G4int GetNofPixelsX() const;
+    G4int GetNofPixelsY() const;
+    std::size_t GetMemorySize() const;
+
+  private:
+    G4int fNx = 0;
+    G4int fNy = 0;
+    G4double fHalfX = 0.;
+    G4double fHalfY = 0.;
+    G4int fNbinsE = 256;
+    G4double fEmax = 10. * CLHEP::MeV;
+    G4double fInvWidthE = 0.;
+    CacheAlignedArray<G4double> fCounts;
+    CacheAlignedArray<G4double> fEnergies;
+    CacheAlignedArray<G4double> fSpectra;
+};
+
+// inline functions
+
+inline void PixelAccumulable::Fill(std::size_t pixel, G4double energy,
+                                   G4double weight)
+{
+  fCounts[pixel] += weight;
+  fEnergies[pixel] += weight * energy / CLHEP::MeV;
+
+  auto bin = energy * fInvWidthE;
+  if ( bin >= 0. && bin < fNbinsE ) {
+    fSpectra[pixel * fNbinsE + static_cast<std::size_t>(bin)] += weight;
+  }
+}
+
+inline G4bool PixelAccumulable::IsActive() const {
+  return fCounts.Size() > 0;
+}
+
+inline G4int PixelAccumulable::GetNofPixelsX() const {
+  return fNx;
+}
+
+inline G4int PixelAccumulable::GetNofPixelsY() const {
+  return fNy;
+}
+
+inline std::size_t PixelAccumulable::GetMemorySize() const {
+  return (fCounts.Size() + fEnergies.Size() + fSpectra.Size())
+         * sizeof(G4double);
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -31,10 +31,20 @@
 #define B4PrimaryGeneratorAction_h 1
 
 #include "G4VUserPrimaryGeneratorAction.hh"
+#include "G4ThreeVector.hh"
+#include "CacheAlignedArray.hh"
+#include "EnergySpectrum.hh"
+#include "PhaseSpaceReader.hh"
+#include "HaltonSequence.hh"
 #include "globals.hh"
+#include "CLHEP/Random/MixMaxRng.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <vector>
 
 class G4ParticleGun;
 class G4Event;
+class G4GenericMessenger;
 
 namespace B4
 {
@@ -45,6 +55,70 @@ namespace B4
 /// perpendicular to the input face. The type of the particle
 /// can be changed via the G4 build-in commands of G4ParticleGun class
 /// (see the macros provided with this example).
+///
+/// The neutrons are emitted uniformly in an 8 deg cone around the z axis.
+/// With /phantom/source/direction biased, the directions are sampled from
+/// a mixture of this cone (with the analogFraction probability) and of
+/// sub-cones pointing at the regions of interest, e.g. the phantoms,
+/// added with /phantom/source/addCone. Each primary vertex then carries
+/// the weight analog density / biased density of its direction.
+///
+/// The neutron energy is the gun energy (2.5 MeV by default), or it is
+/// sampled from a tabulated EnergySpectrum loaded via
+/// /phantom/source/spectrum, e.g. a D-D, Am-Be or measured moderated
+/// spectrum table, or the built-in Cf-252 Watt spectrum. Each thread
+/// builds its alias table once, when the spectrum is loaded.
+/// With an energy scan (see EnergyScan), the energy is instead sampled
+/// in the scan energy bin selected for the event, and the primary
+/// particle is tagged with this bin (see PrimaryInfo).
+///
+/// The primaries are sampled by batches of /phantom/source/batchSize
+/// (256 by default), which are used over several events: the random
+/// numbers are drawn with flatArray() and the directions computed with a
+/// vectorisable kernel over structure of arrays buffers;
+/// GeneratePrimaries() then only takes the next primary from the buffers.
+/// The batches are drawn from a random stream of the thread, seeded at
+/// the first event of each run from /phantom/source/batchSeed, the run ID
+/// and the thread ID, and not from the event seeds: a sequential run is
+/// reproducible, but in a multi-threaded run the source of an event
+/// depends on the thread which processes it and on the order of its
+/// events, so that the run is reproducible only statistically. With a
+/// batch size of 1, each primary is instead sampled from the event random
+/// numbers, and multi-threaded runs are reproducible
+/// (see benchmark_batch.mac for the cost of both). The buffers are
+/// discarded whenever the source settings change. The time spent in
+/// GeneratePrimaries() is accumulated per run (GetSamplingTime()).
+/// The position is the gun position, or it is uniform in a disk around
+/// it (/phantom/source/spotRadius).
+///
+/// Each event has /phantom/source/primariesPerEvent independent
+/// primaries (1 by default, so that /run/beamOn counts neutrons), each in
+/// its own vertex; with several primaries the per event overhead is shared
+/// by several neutrons when the events are small, e.g. at low energies
+/// (see benchmark_primaries.mac); the detector values are still accounted
+/// per primary (see B4a::TrackingAction and B4a::EventAction).
+///
+/// With /phantom/source/sampling qmc, the random numbers of the source
+/// (cos theta, phi, cone selection, energy, spot x/y) are instead the
+/// coordinates of a scrambled Halton sequence (see HaltonSequence), one
+/// point per primary, numbered by the event ID and the primary index in
+/// the event: each thread computes the points of its own events,
+/// so that the run does not depend on the number of threads. The
+/// scrambling is drawn from /phantom/source/qmcSeed and the run ID, and
+/// the primaries are not batched.
+///
+/// With /phantom/source/phaseSpaceFile, the source is instead the
+/// memory mapped phase space file written in a previous run with the
+/// moderator (see B4::PhaseSpaceWriter): each record gives the position,
+/// direction, energy and weight of one primary. The records can be
+/// used several times (phaseSpaceRecycle), and then optionally rotated
+/// by a random angle around the z axis (phaseSpaceRotate). As with QMC,
+/// the record of a primary is given by its index in the run, i.e. by the
+/// event ID and the primary index in the event: the threads never share
+/// a record, the run does not depend on the number of threads, and each
+/// run replays the file from its first record. When the run needs more
+/// records than the file has, they are replayed from the beginning,
+/// with a warning.
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -54,10 +128,112 @@ public:
 
   void GeneratePrimaries(G4Event* event) override;
 
+  // get methods
+  G4double GetSamplingTime() const;
+
+  // set methods
+  void SetDirectionMode(const G4String& mode);
+  void AddCone(const G4String& cone);
+  void ClearCones();
+  void SetEnergyMode(const G4String& mode);
+  void SetSpectrum(const G4String& spectrum);
+  void SetAnalogFraction(G4double fraction);
+  void SetBatchSize(G4int batchSize);
+  void SetNofPrimaries(G4int nofPrimaries);
+  void SetSampling(const G4String& mode);
+  void SetQMCSeed(G4int seed);
+  void SetSpotRadius(G4double radius);
+  void SetSourceType(const G4String& type);
+  void SetPhaseSpaceFile(const G4String& fileName);
+
 private:
+  /// A biasing cone around fAxis with its selection probability
+  struct Cone {
+    G4ThreeVector fAxis;
+    G4double fCosHalfAngle = 1.;
+    G4double fProbability = 0.;
+  };
+
+  static constexpr G4double kConeHalfAngle = 8. * CLHEP::deg;
+
+  // the first dimension of the source random numbers
+  static constexpr G4int kDimCosTheta = 0;  // and phi, cone selection
+  static constexpr G4int kDimEnergy = 3;    // two for the alias table
+  static constexpr G4int kDimSpot = 5;      // radius and angle
+
+  // methods
+  void DefineCommands();
+  void GenerateGunPrimary(G4Event* event, G4long primaryIndex);
+  void GeneratePhaseSpacePrimary(G4Event* event, G4long primaryIndex);
+  void FillBatch(std::size_t n);
+  void StartRun(G4int runID);
+  void SetQMCPoint(G4long primaryIndex);
+  void DrawUniforms(G4int firstDim, G4int nofDims, std::size_t n);
+  void InvalidateBatch();
+
+  // data members
   G4ParticleGun* fParticleGun = nullptr; // G4 particle gun
+  G4GenericMessenger* fMessenger = nullptr;
+
+  G4int fNofPrimaries = 1;
+
+  G4bool fBiasDirection = false;
+  G4double fAnalogFraction = 0.1;
+  std::vector<Cone> fCones;
+
+  G4bool fUseSpectrum = false;
+  EnergySpectrum fSpectrum;
+
+  G4double fCosConeHalfAngle = 1.;
+
+  // primaries batch, as structure of arrays
+  std::size_t fBatchSize = 256;
+  std::size_t fBatchCount = 0;  ///< the primaries in the current batch
+  std::size_t fBatchIndex = 0;
+  CacheAlignedArray<G4double> fBatchDirX;
+  CacheAlignedArray<G4double> fBatchDirY;
+  CacheAlignedArray<G4double> fBatchDirZ;
+  CacheAlignedArray<G4double> fBatchPosX;
+  CacheAlignedArray<G4double> fBatchPosY;
+  CacheAlignedArray<G4double> fBatchEnergy;
+  CacheAlignedArray<G4double> fBatchWeight;
+  CacheAlignedArray<G4double> fBatchCosHalfAngle;
+  CacheAlignedArray<G4double> fRandoms;
+  std::vector<G4int> fBatchCone;  ///< the biasing cone, or -1
+  CLHEP::MixMaxRng fBatchEngine;  ///< the batch random stream
+  G4int fBatchSeed = 0;
+  G4int fRunID = -1;
+  G4double fSamplingTime = 0.;  ///< in s, in the current run
+
+  G4double fSpotRadius = 0.;
+
+  // quasi Monte Carlo sampling
+  G4bool fUseQMC = false;
+  HaltonSequence fQMC;
+  G4int fQMCSeed = 0;
+  G4int fQMCRunID = -1;
+  std::uint64_t fQMCIndex = 0;
+
+  // phase space source
+  G4bool fUsePhaseSpace = false;
+  PhaseSpaceReader fPhaseSpace;
+  G4int fPhaseSpaceRecycle = 1;
+  G4bool fPhaseSpaceRotate = false;
+  G4bool fPhaseSpaceWrapped = false;
+  G4ThreeVector fGunPosition;
 };
 
+// inline functions
+
+inline G4double PrimaryGeneratorAction::GetSamplingTime() const {
+  return fSamplingTime;
+}
+
+inline void PrimaryGeneratorAction::InvalidateBatch() {
+  fBatchCount = 0;
+  fBatchIndex = 0;
+}
+
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -24,44 +24,44 @@
 // ********************************************************************
 //
 //
-/// \file B4/B4a/include/SteppingAction.hh
-/// \brief Definition of the B4a::SteppingAction class
+/// \file B4/B4a/include/PrimaryInfo.hh
+/// \brief Definition of the B4::PrimaryInfo class
 
-#ifndef B4aSteppingAction_h
-#define B4aSteppingAction_h 1
+#ifndef B4PrimaryInfo_h
+#define B4PrimaryInfo_h 1
 
-#include "G4UserSteppingAction.hh"
+#include "G4VUserPrimaryParticleInformation.hh"
+#include "globals.hh"
 
 namespace B4
 {
-  class DetectorConstruction;
-}
-
-namespace B4a
-{
-
-class EventAction;
 
-/// Stepping action class.
+/// Primary particle information
 ///
-/// In UserSteppingAction() there are collected the energy deposit and track
-/// lengths of charged particles in Absober and Gap layers and
-/// updated in EventAction.
+/// It tags the primary particle with its energy scan bin
+/// (see EnergyScan); it is read in B4a::EventAction and B4a::DetectorSD.
 
-class SteppingAction : public G4UserSteppingAction
+class PrimaryInfo : public G4VUserPrimaryParticleInformation
 {
-public:
-  SteppingAction(const B4::DetectorConstruction* detConstruction,
-                 EventAction* eventAction);
-  ~SteppingAction() override = default;
+  public:
+    explicit PrimaryInfo(G4int energyBin);
+    ~PrimaryInfo() override = default;
 
-  void UserSteppingAction(const G4Step* step) override;
+    void Print() const override;
 
-private:
-  const B4::DetectorConstruction* fDetConstruction = nullptr;
-  EventAction* fEventAction = nullptr;
+    // get methods
+    G4int GetEnergyBin() const;
+
+  private:
+    G4int fEnergyBin = -1;
 };
 
+// inline functions
+
+inline G4int PrimaryInfo::GetEnergyBin() const {
+  return fEnergyBin;
+}
+
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -31,9 +31,21 @@
 #define B4RunAction_h 1
 
 #include "G4UserRunAction.hh"
+#include "G4Accumulable.hh"
+#include "G4Timer.hh"
 #include "globals.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include "ImageAccumulable.hh"
+#include "ImageCubeAccumulable.hh"
+#include "PixelAccumulable.hh"
+#include "TallyAccumulable.hh"
+
+#include <memory>
+#include <vector>
 
 class G4Run;
+class G4GenericMessenger;
 
 namespace B4
 {
@@ -55,19 +67,168 @@ namespace B4
 /// In EndOfRunAction(), the accumulated statistic and computed
 /// dispersion is printed.
 ///
+/// The neutron positions in the detector are accumulated per thread in
+/// a dense ImageAccumulable ("h2"), which is merged into the master
+/// at the end of run and exported to the h2 H2 histogram.
+/// Optionally, an energy resolved (x, y, E) ImageCubeAccumulable is
+/// filled from the same detector hook; its layout is set via
+/// /phantom/image/cube/ commands and it is written by the master
+/// in a binary file at the end of run.
+///
+/// With a pixelated detector, the pixel hits, energies and pulse height
+/// spectra are accumulated in a PixelAccumulable ("pixels") by
+/// B4a::DetectorSD; the spectrum binning and the output file are set via
+/// /phantom/image/pixels/ commands, and the master writes the pixels in
+/// a binary file at the end of run.
+///
+/// The master also prints the run time and the numbers of events and
+/// of primaries per second, and the time spent in the primary generation
+/// per primary (see PrimaryGeneratorAction::GetSamplingTime()).
+///
+/// The numbers of secondary tracks killed or deferred by the
+/// B4a::StackingAction are accumulated and printed at the end of run.
+/// So are the numbers of neutrons killed in each kill zone
+/// (see B4a::KillZoneSD).
+/// With the scoring world, the neutron entries and track lengths in each
+/// scoring volume (see B4a::ScoringSD) are printed as well.
+///
+/// When the geometry has a phase space plane, the master opens the
+/// phase space file (/phantom/phasespace/fileName) at the beginning of
+/// run; each thread flushes its records at the end of run, and then
+/// the master closes the file.
+///
+/// With an energy scan (see EnergyScan), energy sliced copies of the
+/// EDetector and LDetector histograms and of the h2 image
+/// ("EDetector_<bin>", "LDetector_<bin>", "h2_<bin>") are booked at the
+/// beginning of run and filled per primary energy bin, via FillSlice()
+/// and by B4a::DetectorSD; the bin is also saved in the ntuple
+/// "EnergyBin" column (-1 without a scan).
+///
+/// With importance biasing, the split tracks of a primary carry a
+/// fraction of its weight, and the weighted sum of their deposits is not
+/// the pulse height of any history: only its mean is unbiased. The
+/// EDetector and LDetector histograms (with their slices) and the ntuple
+/// are then not booked, and only the means, computed from the weighted
+/// sums accumulated via AddDetectorTotals(), are printed.
+///
 
 class RunAction : public G4UserRunAction
 {
   public:
-    RunAction();
-    ~RunAction() override = default;
+    explicit RunAction(G4bool pulseHeightSpectra = true);
+    ~RunAction() override;
 
     void BeginOfRunAction(const G4Run*) override;
     void   EndOfRunAction(const G4Run*) override;
 
+    void AddKilledTrack();
+    void AddDeferredTrack();
+    void AddPrimaries(G4int nofPrimaries);
+    void AddSteps(G4int nofSteps);
+    void AddDetectorTotals(G4double edep, G4double trackL, G4double weight);
+    void FillSlice(G4int bin, G4double energy, G4double trackL,
+                   G4double weight);
+
+    // get methods
+    G4bool HasPulseHeightSpectra() const;
+
+    // set methods
+    void SetPhaseSpaceKillRecorded(G4bool value);
+
+  private:
+    // methods
+    void DefineCommands();
+    void SetCubeLayout();
+    void BookEnergySlices();
+
+    // image binning, shared by the h2 histogram and its accumulable
+    static constexpr G4int kImageNbins = 300;
+    static constexpr G4double kImageMin = -100.;
+    static constexpr G4double kImageMax = 100.;
+
+    ImageAccumulable fImage { "h2",
+                              kImageNbins, kImageMin, kImageMax,
+                              kImageNbins, kImageMin, kImageMax };
+
+    // energy resolved image cube and its layout
+    static constexpr std::size_t kCubeMaxBins = 1 << 28;
+
+    ImageCubeAccumulable fCube { "cube" };
+    G4bool   fCubeEnabled = false;
+    G4int    fCubeNbinsXY = 100;
+    G4int    fCubeNbinsE = 70;
+    G4double fCubeEmin = 1. * CLHEP::eV;
+    G4double fCubeEmax = 10. * CLHEP::MeV;
+    G4String fCubeFileName = "B4_cube.bin";
+
+    // pixelated detector readout and its spectrum binning
+    PixelAccumulable fPixels { "pixels" };
+    G4int    fPixelNbinsE = 256;
+    G4double fPixelEmax = 10. * CLHEP::MeV;
+    G4String fPixelFileName = "B4_pixels.bin";
+
+    // detector spectra, or only their means (with importance biasing)
+    G4bool fPulseHeightSpectra = true;
+    G4Accumulable<G4double> fSumEdep = 0.;
+    G4Accumulable<G4double> fSumTrackL = 0.;
+    G4Accumulable<G4double> fSumWeight = 0.;
 
+    G4Accumulable<G4long> fNofPrimaries = 0;
+    G4Accumulable<G4long> fNofSteps = 0;
+    G4Accumulable<G4double> fSamplingTime = 0.;  // in s
+
+    // suppressed secondary tracks
+    G4Accumulable<G4long> fNofKilledTracks = 0;
+    G4Accumulable<G4long> fNofDeferredTracks = 0;
+    TallyAccumulable fKillZoneTally { "KillZones" };
+
+    // scoring world tallies
+    TallyAccumulable fScoringCurrentTally { "ScoringCurrent" };
+    TallyAccumulable fScoringTrackLengthTally { "ScoringTrackLength" };
+
+    G4String fPhaseSpaceFileName = "B4_phasespace.bin";
+
+    // energy scan slices, only ever appended as the scan grows
+    std::vector<G4int> fSliceEDetectorIds;
+    std::vector<G4int> fSliceLDetectorIds;
+    std::vector<G4int> fSliceH2Ids;
+    std::vector<std::unique_ptr<ImageAccumulable>> fSliceImages;
+
+    G4Timer fTimer;
+    G4GenericMessenger* fMessenger = nullptr;
+    G4GenericMessenger* fPhaseSpaceMessenger = nullptr;
+    G4GenericMessenger* fPixelMessenger = nullptr;
 };
 
+// inline functions
+
+inline void RunAction::AddKilledTrack() {
+  fNofKilledTracks += 1;
+}
+
+inline void RunAction::AddDeferredTrack() {
+  fNofDeferredTracks += 1;
+}
+
+inline void RunAction::AddPrimaries(G4int nofPrimaries) {
+  fNofPrimaries += nofPrimaries;
+}
+
+inline void RunAction::AddSteps(G4int nofSteps) {
+  fNofSteps += nofSteps;
+}
+
+inline void RunAction::AddDetectorTotals(G4double edep, G4double trackL,
+                                         G4double weight) {
+  fSumEdep += edep;
+  fSumTrackL += trackL;
+  fSumWeight += weight;
+}
+
+inline G4bool RunAction::HasPulseHeightSpectra() const {
+  return fPulseHeightSpectra;
+}
+
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
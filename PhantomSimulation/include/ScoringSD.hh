@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/ScoringSD.hh
+/// \brief Definition of the B4a::ScoringSD class
+
+#ifndef B4aScoringSD_h
+#define B4aScoringSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+class G4Step;
+
+namespace B4
+{
+  class TallyAccumulable;
+}
+
+namespace B4a
+{
+
+/// Scoring volume sensitive detector class
+///
+/// It is attached to the tally planes and ROI boxes of the parallel
+/// scoring world (see B4::ScoringWorldConstruction), so the steps it
+/// sees are limited by the scoring volume boundaries only.
+/// In ProcessHits(), the neutrons entering a scoring volume are counted
+/// in the "ScoringCurrent" tally accumulable and their weighted track
+/// length (in mm) is summed in the "ScoringTrackLength" one, per volume;
+/// the fluence in a volume is its track length divided by its volume.
+/// The tallies are printed at the end of run.
+
+class ScoringSD : public G4VSensitiveDetector
+{
+  public:
+    ScoringSD(const G4String& name);
+    ~ScoringSD() override = default;
+
+    // methods from base class
+    void   Initialize(G4HCofThisEvent* hitCollection) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+
+  private:
+    B4::TallyAccumulable* fCurrentTally = nullptr;
+    B4::TallyAccumulable* fTrackLengthTally = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,98 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/ScoringWorldConstruction.hh
+/// \brief Definition of the B4::ScoringWorldConstruction class
+
+#ifndef B4ScoringWorldConstruction_h
+#define B4ScoringWorldConstruction_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4LogicalVolume;
+
+namespace B4
+{
+
+class ScoringWorldMessenger;
+
+/// Parallel world of the scoring volumes.
+///
+/// Tally planes (1 mm thick, spanning the world in x and y) and ROI
+/// boxes are defined via /phantom/scoring/ commands (see
+/// ScoringWorldMessenger) and placed in this world, so that they do not
+/// change the mass geometry or its navigation voxels; they may overlap
+/// the mass volumes but not each other. The neutrons crossing them are
+/// scored by B4a::ScoringSD.
+///
+/// The scoring world is activated with the -s option of exampleB4a,
+/// which also enables the command based scoring meshes (/score/
+/// commands); without it, no parallel world is navigated.
+/// Changing the scoring volumes between runs rebuilds the geometry.
+
+class ScoringWorldConstruction : public G4VUserParallelWorld
+{
+  public:
+    explicit ScoringWorldConstruction(const G4String& worldName);
+    ~ScoringWorldConstruction() override;
+
+    void Construct() override;
+    void ConstructSD() override;
+
+    // set methods
+    /// Add a box volume; return false if the name is already used
+    G4bool AddBox(const G4String& name, const G4ThreeVector& center,
+                  const G4ThreeVector& halfSize);
+    void AddPlane(const G4String& name, G4double z);
+    void Clear();
+
+  private:
+    // methods
+    void GeometryHasChanged();
+
+    /// A scoring box; a plane spans the whole world in x and y
+    struct ScoringVolume {
+      G4String fName;
+      G4ThreeVector fCenter;
+      G4ThreeVector fHalfSize;
+      G4bool fIsPlane = false;
+    };
+
+    // data members
+    std::vector<ScoringVolume> fScoringVolumes;
+    std::vector<G4LogicalVolume*> fScoringLVs;
+    ScoringWorldMessenger* fMessenger = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/ScoringWorldMessenger.hh
+/// \brief Definition of the B4::ScoringWorldMessenger class
+
+#ifndef B4ScoringWorldMessenger_h
+#define B4ScoringWorldMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIcommand;
+class G4UIdirectory;
+
+namespace B4
+{
+
+class ScoringWorldConstruction;
+
+/// Messenger class that defines the commands of ScoringWorldConstruction:
+///
+/// - /phantom/scoring/addBox name x y z halfX halfY halfZ unit
+///   ROI box at (x, y, z)
+/// - /phantom/scoring/addPlane name z unit
+///   1 mm thick tally plane spanning the world at z
+/// - /phantom/scoring/clear
+///   remove all scoring volumes
+///
+/// The commands are also available between runs;
+/// the geometry is then rebuilt at the next run.
+
+class ScoringWorldMessenger : public G4UImessenger
+{
+  public:
+    ScoringWorldMessenger(ScoringWorldConstruction* scoringWorld);
+    ~ScoringWorldMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    ScoringWorldConstruction* fScoringWorld = nullptr;
+
+    G4UIdirectory* fScoringDirectory = nullptr;
+    G4UIcommand* fAddBoxCmd = nullptr;
+    G4UIcommand* fAddPlaneCmd = nullptr;
+    G4UIcommand* fClearCmd = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
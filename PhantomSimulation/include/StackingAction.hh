@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/StackingAction.hh
+/// \brief Definition of the B4a::StackingAction class
+
+#ifndef B4aStackingAction_h
+#define B4aStackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4GenericMessenger;
+
+namespace B4
+{
+  class RunAction;
+}
+
+namespace B4a
+{
+
+/// Stacking action class
+///
+/// It drops the secondaries which cannot contribute to the outputs.
+/// The stacking policy is selected via /phantom/stack/ commands:
+/// - full: all secondaries are tracked (default, full detector response)
+/// - neutronImaging: all secondaries but neutrons are killed
+/// In addition, rules can kill or defer (move to the waiting stack)
+/// the secondaries of a given PDG code, optionally only when they are
+/// created in a given physical volume.
+/// The numbers of killed and deferred tracks are accounted in RunAction
+/// and printed at the end of run.
+
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    enum class Policy { kFull, kNeutronImaging };
+
+    StackingAction(B4::RunAction* runAction);
+    ~StackingAction() override;
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+
+    // set methods
+    void SetPolicy(const G4String& policy);
+    void AddKillRule(const G4String& rule);
+    void AddDeferRule(const G4String& rule);
+    void ClearRules();
+
+  private:
+    /// A secondary matching both the PDG code (0 = any) and the creating
+    /// volume name (empty = any) gets the rule classification
+    struct Rule {
+      G4int fPDGCode = 0;
+      G4String fVolumeName;
+      G4ClassificationOfNewTrack fClassification = fUrgent;
+    };
+
+    // methods
+    void DefineCommands();
+    void AddRule(const G4String& rule, G4ClassificationOfNewTrack classification);
+
+    // data members
+    B4::RunAction* fRunAction = nullptr;
+    G4GenericMessenger* fMessenger = nullptr;
+
+    Policy fPolicy = Policy::kFull;
+    std::vector<Rule> fRules;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
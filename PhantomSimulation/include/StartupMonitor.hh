@@ -0,0 +1,95 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/StartupMonitor.hh
+/// \brief Definition of the B4::StartupMonitor class
+
+#ifndef B4StartupMonitor_h
+#define B4StartupMonitor_h 1
+
+#include "G4Timer.hh"
+#include "globals.hh"
+
+namespace B4
+{
+
+/// Startup cost of the application, used to compare the physics lists
+///
+/// The timer is started in main() before the run manager is created, and
+/// stopped at the beginning of the first run on the master, once the
+/// geometry and the physics tables have been built: the startup time thus
+/// includes the initialisation and the table building (and, in interactive
+/// mode, the time spent in the session before the first run).
+/// The resident memory is recorded at the same point and printed with the
+/// peak resident memory at the end of each run (see RunAction).
+
+class StartupMonitor
+{
+  public:
+    static StartupMonitor* Instance();
+
+    /// Start the startup timer, with the name of the selected physics list
+    void Start(const G4String& physicsListName);
+    /// Record the startup time and memory, the first time only
+    void BeginOfRun();
+    /// Print the physics list, the startup time and memory
+    void Print() const;
+
+    // get methods
+    const G4String& GetPhysicsListName() const;
+    G4double GetStartupTime() const;
+
+  private:
+    StartupMonitor() = default;
+    ~StartupMonitor() = default;
+
+    /// the current and peak resident memory in MB (0 if not available)
+    static G4double GetResidentMemory();
+    static G4double GetPeakResidentMemory();
+
+    G4String fPhysicsListName;
+    G4Timer fTimer;
+    G4bool fStarted = false;
+    G4bool fDone = false;
+    G4double fStartupTime = 0.;
+    G4double fStartupMemory = 0.;
+};
+
+// inline functions
+
+inline const G4String& StartupMonitor::GetPhysicsListName() const {
+  return fPhysicsListName;
+}
+
+inline G4double StartupMonitor::GetStartupTime() const {
+  return fStartupTime;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
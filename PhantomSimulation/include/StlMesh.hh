@@ -0,0 +1,111 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/StlMesh.hh
+/// \brief Definition of the B4::StlMesh class
+
+#ifndef B4StlMesh_h
+#define B4StlMesh_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B4
+{
+
+/// Triangle mesh read from a binary STL file
+///
+/// The binary STL format is an 80 bytes header, a uint32 number of facets
+/// and, per facet, the normal and the three vertices (float[3] each,
+/// little endian) followed by a uint16 attribute. The vertices are
+/// ordered anticlockwise seen from outside, as G4TriangularFacet expects;
+/// the normals are not used.
+///
+/// The facets are kept, so that the G4TessellatedSolid can be rebuilt
+/// when the geometry changes without reading the file again.
+
+class StlMesh
+{
+  public:
+    StlMesh() = default;
+    ~StlMesh() = default;
+
+    StlMesh(const StlMesh&) = delete;
+    StlMesh& operator=(const StlMesh&) = delete;
+
+    /// Read the file, with the vertex coordinates in the given unit;
+    /// on failure a warning is issued and false is returned
+    G4bool Load(const G4String& fileName, G4double unit);
+
+    // get methods
+    const G4String& GetFileName() const;
+    std::size_t GetNofFacets() const;
+    /// The vertex 0, 1 or 2 of the facet
+    const G4ThreeVector& GetVertex(std::size_t facet, G4int vertex) const;
+    void GetBoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+    /// The time spent reading the file
+    G4double GetReadTime() const;
+
+  private:
+    G4String fFileName;
+    std::vector<G4ThreeVector> fVertices;  ///< three per facet
+    G4ThreeVector fMin;
+    G4ThreeVector fMax;
+    G4double fReadTime = 0.;
+};
+
+// inline functions
+
+inline const G4String& StlMesh::GetFileName() const {
+  return fFileName;
+}
+
+inline std::size_t StlMesh::GetNofFacets() const {
+  return fVertices.size() / 3;
+}
+
+inline const G4ThreeVector& StlMesh::GetVertex(std::size_t facet,
+                                               G4int vertex) const {
+  return fVertices[3 * facet + vertex];
+}
+
+inline void StlMesh::GetBoundingLimits(G4ThreeVector& pMin,
+                                       G4ThreeVector& pMax) const {
+  pMin = fMin;
+  pMax = fMax;
+}
+
+inline G4double StlMesh::GetReadTime() const {
+  return fReadTime;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
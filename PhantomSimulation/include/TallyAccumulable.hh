@@ -0,0 +1,93 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/TallyAccumulable.hh
+/// \brief Definition of the B4::TallyAccumulable class
+
+#ifndef B4TallyAccumulable_h
+#define B4TallyAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <map>
+
+namespace B4
+{
+
+/// Named counters accumulable
+///
+/// It accumulates, per name, the number of entries and the sum of their
+/// statistical weights. The names do not need to be known in advance:
+/// the worker tallies are merged into the master one by name.
+
+class TallyAccumulable : public G4VAccumulable
+{
+  public:
+    struct Tally {
+      G4long fCount = 0;
+      G4double fWeight = 0.;
+    };
+
+    explicit TallyAccumulable(const G4String& name);
+    ~TallyAccumulable() override = default;
+
+    // methods from base class
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    /// Add one entry with the given weight to the named counter
+    void Add(const G4String& name, G4double weight = 1.);
+
+    /// Print all counters, one per line, after the given title
+    void PrintTallies(const G4String& title) const;
+
+    // get methods
+    const std::map<G4String, Tally>& GetTallies() const;
+
+  private:
+    std::map<G4String, Tally> fTallies;
+};
+
+// inline functions
+
+inline void TallyAccumulable::Add(const G4String& name, G4double weight)
+{
+  auto& tally = fTallies[name];
+  tally.fCount += 1;
+  tally.fWeight += weight;
+}
+
+inline const std::map<G4String, TallyAccumulable::Tally>&
+TallyAccumulable::GetTallies() const {
+  return fTallies;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
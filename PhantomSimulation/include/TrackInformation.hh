@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/TrackInformation.hh
+/// \brief Definition of the B4a::TrackInformation class
+
+#ifndef B4aTrackInformation_h
+#define B4aTrackInformation_h 1
+
+#include "G4VUserTrackInformation.hh"
+#include "globals.hh"
+
+namespace B4a
+{
+
+/// Track information class
+///
+/// It keeps the slot of the primary neutron a track descends from,
+/// i.e. the index of its primary vertex in the event, so that the
+/// detector hits of the events with several primaries are accounted
+/// per primary (see TrackingAction and DetectorSD).
+
+class TrackInformation : public G4VUserTrackInformation
+{
+  public:
+    explicit TrackInformation(G4int primarySlot);
+    ~TrackInformation() override = default;
+
+    void Print() const override;
+
+    // get methods
+    G4int GetPrimarySlot() const;
+
+  private:
+    G4int fPrimarySlot = 0;
+};
+
+// inline functions
+
+inline G4int TrackInformation::GetPrimarySlot() const {
+  return fPrimarySlot;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
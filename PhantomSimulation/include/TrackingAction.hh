@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/TrackingAction.hh
+/// \brief Definition of the B4a::TrackingAction class
+
+#ifndef B4aTrackingAction_h
+#define B4aTrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+namespace B4
+{
+  class RunAction;
+}
+
+namespace B4a
+{
+
+/// Tracking action class
+///
+/// It tags each track with the slot of its primary (see TrackInformation):
+/// the primary tracks get the index of their primary vertex, given by
+/// their track ID, and the secondaries inherit the slot of their parent
+/// in PostUserTrackingAction(). With a single primary per event (the
+/// default), no track is tagged: an untagged track belongs to slot 0.
+/// The number of steps of each track is accounted in RunAction,
+/// which prints the stepping rate at the end of run.
+
+class TrackingAction : public G4UserTrackingAction
+{
+  public:
+    TrackingAction(B4::RunAction* runAction);
+    ~TrackingAction() override = default;
+
+    void PreUserTrackingAction(const G4Track* track) override;
+    void PostUserTrackingAction(const G4Track* track) override;
+
+  private:
+    B4::RunAction* fRunAction = nullptr;
+};
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,146 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/include/VoxelPhantom.hh
+/// \brief Definition of the B4::VoxelPhantom class
+
+#ifndef B4VoxelPhantom_h
+#define B4VoxelPhantom_h 1
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B4
+{
+
+/// Voxelised phantom: material indices on a regular grid
+///
+/// The phantom is read by Load() from a text header file, with one
+/// keyword per line (empty lines and lines starting with '#' are ignored):
+/// - dimensions nx ny nz
+/// - voxelSize dx dy dz unit
+/// - type uint8|uint16
+/// - material index name   (one line per material, a G4 or NIST name;
+///                         index < 65536)
+/// - data fileName         (relative to the header directory)
+///
+/// The data file holds nx x ny x nz material indices in the given type
+/// (little endian), x varying fastest, then y, then z: the index of
+/// voxel (ix, iy, iz) is ix + nx * (iy + ny * iz), as the copy number
+/// in G4PhantomParameterisation.
+///
+/// The indices are kept as std::size_t, the type G4PhantomParameterisation
+/// works on, so that they are passed to it without a copy.
+
+class VoxelPhantom
+{
+  public:
+    VoxelPhantom() = default;
+    ~VoxelPhantom() = default;
+
+    VoxelPhantom(const VoxelPhantom&) = delete;
+    VoxelPhantom& operator=(const VoxelPhantom&) = delete;
+
+    /// Read the header and the data file; on failure a warning is issued,
+    /// false is returned and the phantom loaded before is kept
+    G4bool Load(const G4String& headerFileName);
+
+    // get methods
+    const G4String& GetFileName() const;
+    G4int GetNofVoxelsX() const;
+    G4int GetNofVoxelsY() const;
+    G4int GetNofVoxelsZ() const;
+    std::size_t GetNofVoxels() const;
+    /// The half sizes of one voxel
+    G4ThreeVector GetVoxelHalfSize() const;
+    /// The half sizes of the whole grid
+    G4ThreeVector GetHalfSize() const;
+    const std::vector<G4String>& GetMaterialNames() const;
+    std::size_t* GetMaterialIndices();
+
+  private:
+    static G4bool ReadData(const G4String& fileName, std::size_t nofVoxels,
+                           G4int bytesPerVoxel, std::size_t nofMaterials,
+                           std::vector<std::size_t>& materialIndices,
+                           G4String& error);
+
+    /// the material indices are at most 16 bit
+    static constexpr std::size_t kMaxNofMaterials = 65536;
+
+    G4String fFileName;
+    G4int fNofVoxels[3] = { 0, 0, 0 };
+    G4ThreeVector fVoxelHalfSize;
+    std::vector<G4String> fMaterialNames;
+    std::vector<std::size_t> fMaterialIndices;
+};
+
+// inline functions
+
+inline const G4String& VoxelPhantom::GetFileName() const {
+  return fFileName;
+}
+
+inline G4int VoxelPhantom::GetNofVoxelsX() const {
+  return fNofVoxels[0];
+}
+
+inline G4int VoxelPhantom::GetNofVoxelsY() const {
+  return fNofVoxels[1];
+}
+
+inline G4int VoxelPhantom::GetNofVoxelsZ() const {
+  return fNofVoxels[2];
+}
+
+inline std::size_t VoxelPhantom::GetNofVoxels() const {
+  return fMaterialIndices.size();
+}
+
+inline G4ThreeVector VoxelPhantom::GetVoxelHalfSize() const {
+  return fVoxelHalfSize;
+}
+
+inline G4ThreeVector VoxelPhantom::GetHalfSize() const {
+  return G4ThreeVector(fNofVoxels[0] * fVoxelHalfSize.x(),
+                       fNofVoxels[1] * fVoxelHalfSize.y(),
+                       fNofVoxels[2] * fVoxelHalfSize.z());
+}
+
+inline const std::vector<G4String>& VoxelPhantom::GetMaterialNames() const {
+  return fMaterialNames;
+}
+
+inline std::size_t* VoxelPhantom::GetMaterialIndices() {
+  return fMaterialIndices.data();
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
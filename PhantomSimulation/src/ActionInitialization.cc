@@ -31,8 +31,8 @@
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
 #include "EventAction.hh"
-#include "SteppingAction.hh"
-#include "DetectorConstruction.hh"
+#include "StackingAction.hh"
+#include "TrackingAction.hh"
 
 using namespace B4;
 
@@ -41,15 +41,15 @@ namespace B4a
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-ActionInitialization::ActionInitialization(DetectorConstruction* detConstruction)
- : fDetConstruction(detConstruction)
+ActionInitialization::ActionInitialization(G4bool importanceBiasing)
+ : fImportanceBiasing(importanceBiasing)
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void ActionInitialization::BuildForMaster() const
 {
-  SetUserAction(new RunAction);
+  SetUserAction(new RunAction(! fImportanceBiasing));
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -57,10 +57,11 @@ void ActionInitialization::BuildForMaster() const
 void ActionInitialization::Build() const
 {
   SetUserAction(new PrimaryGeneratorAction);
-  SetUserAction(new RunAction);
-  auto eventAction = new EventAction;
-  SetUserAction(eventAction);
-  SetUserAction(new SteppingAction(fDetConstruction,eventAction));
+  auto runAction = new RunAction(! fImportanceBiasing);
+  SetUserAction(runAction);
+  SetUserAction(new EventAction(runAction));
+  SetUserAction(new StackingAction(runAction));
+  SetUserAction(new TrackingAction(runAction));
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -28,24 +28,46 @@
 /// \brief Implementation of the B4::DetectorConstruction class
 
 #include "DetectorConstruction.hh"
+#include "DetectorMessenger.hh"
+#include "DetectorSD.hh"
+#include "KillZoneSD.hh"
+#include "NavigationBenchmark.hh"
+#include "PhaseSpaceSD.hh"
+#include "StlMesh.hh"
+#include "VoxelPhantom.hh"
 
 #include "G4Material.hh"
 #include "G4NistManager.hh"
 
 #include "G4Box.hh"
 #include "G4Tubs.hh" //Este lo he puesto yo
+#include "G4TessellatedSolid.hh"
+#include "G4TriangularFacet.hh"
 #include "G4LogicalVolume.hh"
 #include "G4RotationMatrix.hh" //Este lo he añadido yo
 #include "G4Transform3D.hh" //Este lo he añadido yo
 #include "G4PVPlacement.hh"
 #include "G4PVReplica.hh"
+#include "G4PVParameterised.hh"
+#include "G4PhantomParameterisation.hh"
 #include "G4GlobalMagFieldMessenger.hh"
 #include "G4AutoDelete.hh"
+#include "G4SDManager.hh"
+
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4RunManager.hh"
+#include "G4UserLimits.hh"
+#include "G4Timer.hh"
 
 #include "G4GeometryManager.hh"
 #include "G4PhysicalVolumeStore.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4SolidStore.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
 
 #include "G4VisAttributes.hh"
 #include "G4Colour.hh"
@@ -55,6 +77,8 @@
 #include "G4SystemOfUnits.hh"
 #include "G4UnionSolid.hh"
 
+#include <algorithm>
+
 namespace B4
 {
 
@@ -65,13 +89,53 @@ G4GlobalMagFieldMessenger* DetectorConstruction::fMagFieldMessenger = nullptr;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+DetectorConstruction::DetectorConstruction(G4bool thermalHydrogen)
+ : fThermalHydrogen(thermalHydrogen)
+{
+  // one entry per region, with the default settings
+  fRegionSettings["Lead"];
+  fRegionSettings["Phantoms"];
+  fRegionSettings["Detector"];
+
+  fMessenger = new DetectorMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorConstruction::~DetectorConstruction()
+{
+  delete fMessenger;
+  for ( auto& [name, settings] : fRegionSettings ) {
+    delete settings.fUserLimits;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 G4VPhysicalVolume* DetectorConstruction::Construct()
 {
-  // Define materials
-  DefineMaterials();
+  // Clean the old geometry, if any (geometry rebuilt between runs)
+  G4GeometryManager::GetInstance()->OpenGeometry();
+  G4PhysicalVolumeStore::GetInstance()->Clean();
+  G4LogicalVolumeStore::GetInstance()->Clean();
+  G4SolidStore::GetInstance()->Clean();
+
+  // Define materials (only once)
+  if ( ! G4Material::GetMaterial("Galactic", false) ) DefineMaterials();
+
+  // Define volumes; the overlaps are checked at each placement (always),
+  // or once the whole geometry is built, unless the same geometry was
+  // already checked (cached)
+  fCheckOverlaps = ( fOverlapCheckMode == OverlapCheckMode::kAlways );
+  auto worldPhys = DefineVolumes();
+  if ( fOverlapCheckMode == OverlapCheckMode::kCached ) {
+    fOverlapCache.Validate(worldPhys);
+  }
 
-  // Define volumes
-  return DefineVolumes();
+  // Smart voxel settings, set via /phantom/navigation/ commands
+  ApplyNavigationSettings();
+
+  return worldPhys;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -97,6 +161,14 @@ void DetectorConstruction::DefineMaterials()
   auto O = G4Element::GetElement("O");
   auto F = G4Element::GetElement("F");
 
+  // Hydrogen bound in polyethylene, for the thermal neutron scattering
+  // data (used for the PLA as well, the closest available hydrogenous
+  // plastic); only with the physics list which has thermal scattering
+  if ( fThermalHydrogen ) {
+    H = new G4Element("TS_H_of_Polyethylene", "H_POLYETHYLENE", 1.,
+                      1.0079*g/mole);
+  }
+
 
  
 
@@ -168,9 +240,9 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
   //
   // World
   //
-  G4double world_hx = 0.5*m; 
-  G4double world_hy = 0.50*m;
-  G4double world_hz = 0.50 * m;
+  G4double world_hx = kWorldHalfSize;
+  G4double world_hy = kWorldHalfSize;
+  G4double world_hz = kWorldHalfSize;
 
   auto worldBox
       = new G4Box("World",           // its name
@@ -192,181 +264,211 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
       0,                                       // copy number
       fCheckOverlaps);                         // checking overlaps
 
+  // The holes placed as daughters are filled with the world material,
+  // like the holes subtracted from the boolean solids
+  auto holeMaterial = defaultMaterial;
 
 
-  /*
-  
-  //Defino bloque de polietileno de 5 cm de espesor
-  G4double pol_hx = 6. * cm;
-  G4double pol_hy = 6. * cm;
-  G4double pol_hz = 2.5 * cm;
 
-  auto polietilenoBox
-      = new G4Box("PolietilenoBox",
-          pol_hx, pol_hy, pol_hz);
+  //
+  // Optional moderator, collimator and polyethylene shielding
+  // (/phantom/geometry/moderator), for the phase space production runs
+  //
+  if ( fModeratorEnabled ) {
 
-  auto polietilenoLV
-      = new G4LogicalVolume(
-          polietilenoBox,
-          polietileno,
-          "PolietilenoLV");
+    //Defino bloque de polietileno de 5 cm de espesor
+    G4double pol_hx = 6. * cm;
+    G4double pol_hy = 6. * cm;
+    G4double pol_hz = 2.5 * cm;
 
+    auto polietilenoBox
+        = new G4Box("PolietilenoBox",
+            pol_hx, pol_hy, pol_hz);
 
-  G4double polPos_x = 0.0 * m;
-  G4double polPos_y = 0.0 * m;
-  G4double polPos_z = -30 * cm;
+    auto polietilenoLV
+        = new G4LogicalVolume(
+            polietilenoBox,
+            polietileno,
+            "PolietilenoLV");
 
-  
-  auto polietilenoPV
-      = new G4PVPlacement(0,                       // no rotation
-          G4ThreeVector(polPos_x, polPos_y, polPos_z),
-          // translation position
-          polietilenoLV,              // its logical volume
-          "PolietilenoPV",               // its name
-          worldLog,                // its mother (logical) volume
-          false,                   // no boolean operations
-          0);                      // its copy number
 
+    G4double polPos_x = 0.0 * m;
+    G4double polPos_y = 0.0 * m;
+    G4double polPos_z = -30 * cm;
 
 
+    auto polietilenoPV
+        = new G4PVPlacement(0,                       // no rotation
+            G4ThreeVector(polPos_x, polPos_y, polPos_z),
+            // translation position
+            polietilenoLV,              // its logical volume
+            "PolietilenoPV",               // its name
+            worldLog,                // its mother (logical) volume
+            false,                   // no boolean operations
+            0);                      // its copy number
 
-  //Creo el volumen del colimador 
 
-  G4double radioInicial = 2.5 * cm;
-  G4double RadioFinal = 6.0 * cm;
-  G4double altura = 1.75 * cm;
-  G4double anguloInicial = 0. * deg;
-  G4double AnguloFinal = 360. * deg;
 
 
-  //Solido:
-  auto colimador
-      = new G4Tubs("colimador",
-          radioInicial,
-          RadioFinal,
-          altura,
-          anguloInicial,
-          AnguloFinal);
-
-  //Ahora creamos el volumen logico:
-  // 
-  auto colimadorLV
-      = new G4LogicalVolume(colimador, polietileno, "ColimadorLV");
+    //Creo el volumen del colimador 
 
+    G4double radioInicial = 2.5 * cm;
+    G4double RadioFinal = 6.0 * cm;
+    G4double altura = 1.75 * cm;
+    G4double anguloInicial = 0. * deg;
+    G4double AnguloFinal = 360. * deg;
 
-  // Creamos el volumen fisico
-  // 
-  G4double xinit = 0.0 * m;
-  G4double yinit = 0.0 * m;
-  G4double zinit = -25.5 * cm;
-    
 
-  auto colimadorPV = new G4PVPlacement(0,  // no rotation 
-      G4ThreeVector(xinit, yinit, zinit),          // at (0,0,0)
-      colimadorLV,                  // its logical volume
-      "ColimadorPV",            // its name
-      worldLog,                  // its mother  volume
-      false,                    // no boolean operation
-      0,                        // copy number
-      fCheckOverlaps);          // checking overlaps
+    //Solido:
+    auto colimador
+        = new G4Tubs("colimador",
+            radioInicial,
+            RadioFinal,
+            altura,
+            anguloInicial,
+            AnguloFinal);
 
+    //Ahora creamos el volumen logico:
+    // 
+    auto colimadorLV
+        = new G4LogicalVolume(colimador, polietileno, "ColimadorLV");
 
 
+    // Creamos el volumen fisico
+    // 
+    G4double xinit = 0.0 * m;
+    G4double yinit = 0.0 * m;
+    G4double zinit = -25.5 * cm;
 
 
-  //Hay una caja de 20 x 20 cm de polietileno que recubre los volúmenes del colimador y de la placa moderadora
+    auto colimadorPV = new G4PVPlacement(0,  // no rotation 
+        G4ThreeVector(xinit, yinit, zinit),          // at (0,0,0)
+        colimadorLV,                  // its logical volume
+        "ColimadorPV",            // its name
+        worldLog,                  // its mother  volume
+        false,                    // no boolean operation
+        0,                        // copy number
+        fCheckOverlaps);          // checking overlaps
 
-  G4double pebox_hx = 2.5 * cm;
-  G4double pebox_hy = 6.0 * cm;
-  G4double pebox_hz = 4.5 * cm;
 
-  auto polietilenoBigBox
-      = new G4Box("PolietilenoBigBox",
-          pebox_hx, pebox_hy, pebox_hz);
 
-  auto polietilenoBigLV
-      = new G4LogicalVolume(
-          polietilenoBigBox,
-          polietileno,
-          "PolietilenoBigLV");
 
-  G4double pePos_x = 8.5 * cm;
-  G4double pePos_y = 0.0 * m;
-  G4double pePos_z = -28 * cm;
 
+    //Hay una caja de 20 x 20 cm de polietileno que recubre los volúmenes del colimador y de la placa moderadora
 
-  auto polietilenoBigPV
-      = new G4PVPlacement(0,                       // no rotation
-          G4ThreeVector(pePos_x, pePos_y, pePos_z),
-          // translation position
-          polietilenoBigLV,              // its logical volume
-          "PolietilenoBigPV",               // its name
-          worldLog,                // its mother (logical) volume
-          false,                   // no boolean operations
-          0);                      // its copy number
+    G4double pebox_hx = 2.5 * cm;
+    G4double pebox_hy = 6.0 * cm;
+    G4double pebox_hz = 4.5 * cm;
 
-  
-  //Creo una caja para el otro lateral
-  G4double innerBox_hx = 2.5 * cm;
-  G4double innerBox_hy = 6.0 * cm;
-  G4double innerBox_hz = 4.5 * cm;
+    auto polietilenoBigBox
+        = new G4Box("PolietilenoBigBox",
+            pebox_hx, pebox_hy, pebox_hz);
 
-  auto solidInnerBox = new G4Box("solidInnerBox",
-      innerBox_hx, innerBox_hy, innerBox_hz);
+    auto polietilenoBigLV
+        = new G4LogicalVolume(
+            polietilenoBigBox,
+            polietileno,
+            "PolietilenoBigLV");
 
-  auto solidInnerBoxLV
-      = new G4LogicalVolume(
-          solidInnerBox,
-          polietileno,
-          "solidInnerBoxLV");
+    G4double pePos_x = 8.5 * cm;
+    G4double pePos_y = 0.0 * m;
+    G4double pePos_z = -28 * cm;
 
-  auto solidInnerBoxPV
-      = new G4PVPlacement(0,
-          G4ThreeVector(-85., 0.0, -280),
-          solidInnerBoxLV,
-          "solidInnerBoxPV",
-          worldLog,
-          false,
-          0);
 
+    auto polietilenoBigPV
+        = new G4PVPlacement(0,                       // no rotation
+            G4ThreeVector(pePos_x, pePos_y, pePos_z),
+            // translation position
+            polietilenoBigLV,              // its logical volume
+            "PolietilenoBigPV",               // its name
+            worldLog,                // its mother (logical) volume
+            false,                   // no boolean operations
+            0);                      // its copy number
 
-  //Creo una caja para el "techo"
-  G4double upperBox_hx = 11.0 * cm;
-  G4double upperBox_hy = 2.5 * cm;
-  G4double upperBox_hz = 4.5 * cm;
 
-  auto solidUpperBox = new G4Box("solidUpperBox",
-      upperBox_hx, upperBox_hy, upperBox_hz);
+    //Creo una caja para el otro lateral
+    G4double innerBox_hx = 2.5 * cm;
+    G4double innerBox_hy = 6.0 * cm;
+    G4double innerBox_hz = 4.5 * cm;
+
+    auto solidInnerBox = new G4Box("solidInnerBox",
+        innerBox_hx, innerBox_hy, innerBox_hz);
+
+    auto solidInnerBoxLV
+        = new G4LogicalVolume(
+            solidInnerBox,
+            polietileno,
+            "solidInnerBoxLV");
+
+    auto solidInnerBoxPV
+        = new G4PVPlacement(0,
+            G4ThreeVector(-85., 0.0, -280),
+            solidInnerBoxLV,
+            "solidInnerBoxPV",
+            worldLog,
+            false,
+            0);
+
+
+    //Creo una caja para el "techo"
+    G4double upperBox_hx = 11.0 * cm;
+    G4double upperBox_hy = 2.5 * cm;
+    G4double upperBox_hz = 4.5 * cm;
+
+    auto solidUpperBox = new G4Box("solidUpperBox",
+        upperBox_hx, upperBox_hy, upperBox_hz);
+
+    auto solidUpperBoxLV
+        = new G4LogicalVolume(
+            solidUpperBox,
+            polietileno, 
+            "solidUpperBoxLV");
+
+    auto solidUpperBoxPV
+        = new G4PVPlacement(0,
+            G4ThreeVector(0.0, 85.0, -280.0),
+            solidUpperBoxLV,
+            "solidUpperBoxPV",
+            worldLog,
+            false,
+            0);
 
-  auto solidUpperBoxLV
-      = new G4LogicalVolume(
-          solidUpperBox,
-          polietileno, 
-          "solidUpperBoxLV");
-
-  auto solidUpperBoxPV
-      = new G4PVPlacement(0,
-          G4ThreeVector(0.0, 85.0, -280.0),
-          solidUpperBoxLV,
-          "solidUpperBoxPV",
-          worldLog,
-          false,
-          0);
-  
 
 
 
 
-  */
+
+    // Visualization attributes
+    //"Blindajes" de PE
+    G4VisAttributes* polietilenoBigVisAtt = new G4VisAttributes(G4Colour(1.0, 0.0, 1.0)); // Azul claritoB
+    polietilenoBigVisAtt->SetVisibility(true);
+    polietilenoBigLV->SetVisAttributes(polietilenoBigVisAtt);
+
+    G4VisAttributes* solidInnerBoxVisAtt = new G4VisAttributes(G4Colour(1.0, 0.0, 1.0)); // Azul claritoB
+    solidInnerBoxVisAtt->SetVisibility(true);
+    solidInnerBoxLV->SetVisAttributes(solidInnerBoxVisAtt);
+
+    G4VisAttributes* solidUpperBoxVisAtt = new G4VisAttributes(G4Colour(1.0, 0.0, 1.0)); // Azul claritoB
+    solidUpperBoxVisAtt->SetVisibility(true);
+    solidUpperBoxLV->SetVisAttributes(solidUpperBoxVisAtt);
+
+    G4VisAttributes* polietilenoVisAtt = new G4VisAttributes(G4Colour(1.0, 1.0, 0.0)); // Azul claritoB
+    polietilenoVisAtt->SetVisibility(true);
+    polietilenoLV->SetVisAttributes(polietilenoVisAtt);
+
+    G4VisAttributes* colimadorVisAtt = new G4VisAttributes(G4Colour(1.0, 1.0, 0.0)); // Azul claritoB
+    colimadorVisAtt->SetVisibility(true);
+    colimadorLV->SetVisAttributes(colimadorVisAtt);
+  }
 
 
 
 
 
   //Creo la caje de plomo de 20.0 cm x 20.  cm x 2.5 cm:
-  G4double plomo_hx = 6. * cm;
-  G4double plomo_hy = 6. * cm;
-  G4double plomo_hz = 1.25 * cm;
+  G4double plomo_hx = kLeadHalfXY;
+  G4double plomo_hy = kLeadHalfXY;
+  G4double plomo_hz = fLeadHalfThickness;
 
   auto plomoBox
       = new G4Box("Plomo",           // its name
@@ -375,8 +477,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
 
   //Voy a crear una caja para recortar el bloque de plomo
-  G4double airBox_hx = 3.0 * cm;
-  G4double airBox_hy = 2.00 * cm;
+  G4double airBox_hx = fLeadCutoutHalfSize.x();
+  G4double airBox_hy = fLeadCutoutHalfSize.y();
   G4double airBox_hz = plomo_hz + 1*cm;
 
   auto airBox
@@ -384,13 +486,6 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
           airBox_hx, airBox_hy, airBox_hz);
 
   
-  //Ahora hacemos el recorte del volumen de plomo con esta caja de aire:
-
-  G4SubtractionSolid* solidPlomoWithHole = new G4SubtractionSolid("PlomoWithHole",
-      plomoBox,
-      airBox,
-      0,
-      G4ThreeVector(plomo_hx-airBox_hx, 0.0, 0.0));
 
 
   G4double plomoPosX = 0.0 * cm;//+5.0 * cm;
@@ -398,7 +493,18 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
   G4double plomoPosZ = 0.0;  // Ajustar según las dimensiones del plomo y el phantom 
 
 
-  auto plomoLV = new G4LogicalVolume(solidPlomoWithHole, plomo, "plomoLV");
+  //Ahora hacemos el recorte del volumen de plomo con esta caja de aire
+  //(modo boolean); en modo daughters el recorte es un volumen hijo
+  G4VSolid* solidPlomo = plomoBox;
+  if ( fHoleMode == HoleMode::kBoolean ) {
+    solidPlomo = new G4SubtractionSolid("PlomoWithHole",
+        plomoBox,
+        airBox,
+        0,
+        G4ThreeVector(plomo_hx-airBox_hx, 0.0, 0.0));
+  }
+
+  auto plomoLV = new G4LogicalVolume(solidPlomo, plomo, "plomoLV");
 
   G4PVPlacement* physPlomo = new G4PVPlacement(0,                              // Sin rotación 
       G4ThreeVector(plomoPosX, plomoPosY, plomoPosZ), // Posición detrás del plomo 
@@ -409,6 +515,14 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
       0,                              // Número de copia
       fCheckOverlaps);                // Chequear superposiciones
 
+  if ( fHoleMode == HoleMode::kDaughters ) {
+    // the cutout daughter is limited to the lead thickness
+    auto airBoxDaughter
+        = new G4Box("AirBoxDaughter", airBox_hx, airBox_hy, plomo_hz);
+    PlaceHole(airBoxDaughter, plomoLV,
+              G4ThreeVector(plomo_hx-airBox_hx, 0.0, 0.0), holeMaterial);
+  }
+
 
 
 
@@ -416,9 +530,9 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
   //Creo el PHANTOM de PLA:
 
     //Creo la caje de plomo de 10.0 cm x 5.0  cm x 1.0 cm:
-  G4double phantom_hx = 1.5 * cm;
-  G4double phantom_hy = 3.0 * cm;
-  G4double phantom_hz = 0.75 * cm;
+  G4double phantom_hx = kPhantomHalfX;
+  G4double phantom_hy = kPhantomHalfY;
+  G4double phantom_hz = kPhantomHalfZ;
 
   auto phantomBox
       = new G4Box("Phantom",           // its name
@@ -428,7 +542,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
   //Ahora CIRCUNFERENCIA DE AIRE DENTRO DEL PHANTOM
   G4double initRadius = 0.0 * m;
-  G4double finRadius = 0.50 * cm;
+  G4double finRadius = fHoleRadii[0];
   G4double high = 0.5 * cm;
   G4double initAngle = 0. * deg;
   G4double finAngle = 360. * deg;
@@ -446,7 +560,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
   //Creo OTRA CIRCUNFERENCIA DE AIRE MÁS PEQUEÑA
   G4double smallTubeInnerRadius = 0.0 * cm; // Radio interno
-  G4double smallTubeOuterRadius = 0.25 * cm; // Radio externo
+  G4double smallTubeOuterRadius = fHoleRadii[1]; // Radio externo
   G4double smallTubeHeight = 1.0 * cm;      // Altura
   G4double smallTubeStartAngle = 0.0 * deg; // Ángulo inicial
   G4double smallTubeSpanningAngle = 360.0 * deg; // Ángulo total (360 grados para un tubo completo)
@@ -462,7 +576,7 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
   //Creo OTRA CIRCUNFERENCIA MÁS PEQUEÑA
   G4double smallerTubeInnerRadius = 0.0 * cm; // Radio interno
-  G4double smallerTubeOuterRadius = 0.125 * cm; // Radio externo
+  G4double smallerTubeOuterRadius = fHoleRadii[2]; // Radio externo
   G4double smallerTubeHeight = 1.0 * cm;      // Altura
   G4double smallerTubeStartAngle = 0.0 * deg; // Ángulo inicial
   G4double smallerTubeSpanningAngle = 360.0 * deg; // Ángulo total (360 grados para un tubo completo)
@@ -481,41 +595,58 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
   G4double phantomPosY = 0.0 * cm; 
   G4double phantomPosZ = (plomo_hz + phantom_hz);  // Ajustar según las dimensiones del plomo y el phantom 
 
-  // Crear la operación booleana de sustracción: PLA - AirTube
-  G4SubtractionSolid* solidPhantomWithHole = new G4SubtractionSolid("PhantomWithHole", // Nombre del nuevo sólido
-      phantomBox,        // Sólido inicial del phantom (PLA)
-      AirTube,      // Sólido a sustraer (cilindro de aire)
-      0,                 // Rotación relativa
-      G4ThreeVector(0, 17.00, 0)); // Traslación relativa
-
-  G4SubtractionSolid* solidPhantomWith2Holes = new G4SubtractionSolid("PhantomWith2Holes",
-      solidPhantomWithHole,
-      smallTube,
-      0,
-      G4ThreeVector(0, 0.0, 0.0));
-
-
-
 
-  G4SubtractionSolid* solidPhantomWith3Holes = new G4SubtractionSolid("PhantomWith3Holes",
-      solidPhantomWith2Holes,
-      smallerTube,
-      0,
-      G4ThreeVector(0, -17.0, 0.0));
 
 
+  // An imported STL mesh replaces the phantom box and its holes
+  G4ThreeVector phantomPosition(0, phantomPosY, phantomPosZ);
+  G4VSolid* solidPhantom = phantomBox;
+  if ( fStlMeshes[0] ) {
+    solidPhantom = BuildStlSolid("PhantomStl", *fStlMeshes[0], phantomPosition);
+  }
 
-  G4LogicalVolume* phantomLV = new G4LogicalVolume(solidPhantomWith3Holes, PLA, "phantomLV");
-
+  // Crear la operación booleana de sustracción: PLA - AirTube
+  // (modo boolean); en modo daughters los agujeros son volúmenes hijos
+  else if ( fHoleMode == HoleMode::kBoolean ) {
+    G4SubtractionSolid* solidPhantomWithHole = new G4SubtractionSolid("PhantomWithHole", // Nombre del nuevo sólido
+        phantomBox,        // Sólido inicial del phantom (PLA)
+        AirTube,      // Sólido a sustraer (cilindro de aire)
+        0,                 // Rotación relativa
+        G4ThreeVector(0, kHoleOffsetY, 0)); // Traslación relativa
+
+    G4SubtractionSolid* solidPhantomWith2Holes = new G4SubtractionSolid("PhantomWith2Holes",
+        solidPhantomWithHole,
+        smallTube,
+        0,
+        G4ThreeVector(0, 0.0, 0.0));
+
+    solidPhantom = new G4SubtractionSolid("PhantomWith3Holes",
+        solidPhantomWith2Holes,
+        smallerTube,
+        0,
+        G4ThreeVector(0, -kHoleOffsetY, 0.0));
+  }
 
-  G4PVPlacement* physPhantom = new G4PVPlacement(0,                             // Sin rotación 
-      G4ThreeVector(0, phantomPosY, phantomPosZ), // Posición detrás del plomo 
-      phantomLV,                      // Volumen lógico del phantom 
-      "PhantomPV",                    // Nombre del volumen físico del phantom 
-      worldLog,                       // Volumen madre (world) 
-      false,                          // No usar operación booleana 
-      0,                              // Número de copia
-      fCheckOverlaps);                // Chequear superposiciones
+  G4LogicalVolume* phantomLV = new G4LogicalVolume(solidPhantom, PLA, "phantomLV");
+
+
+  // the voxel phantom replaces the PLA and teflon phantoms
+  if ( ! fVoxelPhantom ) {
+    G4PVPlacement* physPhantom = new G4PVPlacement(0,                             // Sin rotación 
+        phantomPosition,                // Posición detrás del plomo 
+        phantomLV,                      // Volumen lógico del phantom 
+        "PhantomPV",                    // Nombre del volumen físico del phantom 
+        worldLog,                       // Volumen madre (world) 
+        false,                          // No usar operación booleana 
+        0,                              // Número de copia
+        fCheckOverlaps);                // Chequear superposiciones
+
+    if ( fHoleMode == HoleMode::kDaughters && ! fStlMeshes[0] ) {
+      PlaceHole(AirTube, phantomLV, G4ThreeVector(0, kHoleOffsetY, 0), holeMaterial);
+      PlaceHole(smallTube, phantomLV, G4ThreeVector(), holeMaterial);
+      PlaceHole(smallerTube, phantomLV, G4ThreeVector(0, -kHoleOffsetY, 0), holeMaterial);
+    }
+  }
 
 
 
@@ -524,9 +655,9 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
   //Creo OTRO PHANTOM de TEFLÓN:
 
-  G4double phantom2_hx = 1.5 * cm;
-  G4double phantom2_hy = 3.0 * cm;
-  G4double phantom2_hz = 0.75 * cm;
+  G4double phantom2_hx = kPhantomHalfX;
+  G4double phantom2_hy = kPhantomHalfY;
+  G4double phantom2_hz = kPhantomHalfZ;
 
   auto phantom2Box
       = new G4Box("Phantom2",           // its name
@@ -535,8 +666,8 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
   //Ahora recortamos unos rectángulos de aire:
 
-  G4double air_hx = 0.5 * cm;
-  G4double air_hy = 0.25 * cm;
+  G4double air_hx = fSlotHalfSizes[0].x();
+  G4double air_hy = fSlotHalfSizes[0].y();
   G4double air_hz = phantom2_hz;
 
   auto airRectangle
@@ -545,21 +676,14 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
 
 
-  //Ahora hacemos el recorte del volumen de plomo con esta caja de aire:
-
-  G4SubtractionSolid* solidPhantom2WithHole = new G4SubtractionSolid("Phantom2WithHole",
-      phantom2Box,
-      airRectangle,
-      0,
-      G4ThreeVector(0.0, 15.50, 0.0));
 
 
 
 
   //Ahora recortamos OTRO rectángulo de aire:
 
-  G4double air2_hx = 0.25 * cm;
-  G4double air2_hy = 0.125 * cm;
+  G4double air2_hx = fSlotHalfSizes[1].x();
+  G4double air2_hy = fSlotHalfSizes[1].y();
   G4double air2_hz = phantom2_hz;
 
   auto airRectangle2
@@ -568,20 +692,13 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
 
 
-  //Ahora hacemos el recorte del volumen de plomo con esta caja de aire:
-
-  G4SubtractionSolid* solidPhantom2With2Holes = new G4SubtractionSolid("Phantom2With2Holes",
-      solidPhantom2WithHole,
-      airRectangle2,
-      0,
-      G4ThreeVector(0.0, 0.0, 0.0));
 
 
 
   //Ahora recortamos OTRO rectángulo de aire:
 
-  G4double air3_hx = 0.125 * cm;
-  G4double air3_hy = 0.05 * cm;
+  G4double air3_hx = fSlotHalfSizes[2].x();
+  G4double air3_hy = fSlotHalfSizes[2].y();
   G4double air3_hz = phantom2_hz;
 
   auto airRectangle3
@@ -591,29 +708,69 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
 
 
-  //Ahora hacemos el recorte del volumen de plomo con esta caja de aire:
-
-  G4SubtractionSolid* solidPhantom2With3Holes = new G4SubtractionSolid("Phantom2With3Holes",
-      solidPhantom2With2Holes,
-      airRectangle3,
-      0,
-      G4ThreeVector(0.0, -15.50, 0.0));
 
 
   G4double phantom4PosX = -3.5 * cm;//+5.0 * cm;
   G4double phantom4PosY = 0.0 * cm;
   G4double phantom4PosZ = (plomo_hz + phantom2_hz);  // Ajustar según las dimensiones del plomo y el phantom 
 
-  auto phantom2LV = new G4LogicalVolume(solidPhantom2With3Holes, teflon, "phantom2LV");
+  // An imported STL mesh replaces the phantom box and its slots
+  G4ThreeVector phantom2Position(phantom4PosX, phantom4PosY, phantom4PosZ);
+  G4VSolid* solidPhantom2 = phantom2Box;
+  if ( fStlMeshes[1] ) {
+    solidPhantom2 = BuildStlSolid("Phantom2Stl", *fStlMeshes[1], phantom2Position);
+  }
 
-  G4PVPlacement* physPhantom4 = new G4PVPlacement(0,                              // Sin rotación 
-      G4ThreeVector(phantom4PosX, phantom4PosY, phantom4PosZ), // Posición detrás del plomo 
-      phantom2LV,                      // Volumen lógico del phantom 
-      "phantomPV",                    // Nombre del volumen físico del phantom 
-      worldLog,                       // Volumen madre (world) 
-      false,                          // No usar operación booleana 
-      0,                              // Número de copia
-      fCheckOverlaps);                // Chequear superposiciones
+  //Ahora hacemos el recorte del volumen de teflón con estas cajas de aire
+  //(modo boolean); en modo daughters las ranuras son volúmenes hijos
+  else if ( fHoleMode == HoleMode::kBoolean ) {
+    G4SubtractionSolid* solidPhantom2WithHole = new G4SubtractionSolid("Phantom2WithHole",
+        phantom2Box,
+        airRectangle,
+        0,
+        G4ThreeVector(0.0, kSlotOffsetY, 0.0));
+
+    G4SubtractionSolid* solidPhantom2With2Holes = new G4SubtractionSolid("Phantom2With2Holes",
+        solidPhantom2WithHole,
+        airRectangle2,
+        0,
+        G4ThreeVector(0.0, 0.0, 0.0));
+
+    solidPhantom2 = new G4SubtractionSolid("Phantom2With3Holes",
+        solidPhantom2With2Holes,
+        airRectangle3,
+        0,
+        G4ThreeVector(0.0, -kSlotOffsetY, 0.0));
+  }
+
+  auto phantom2LV = new G4LogicalVolume(solidPhantom2, teflon, "phantom2LV");
+
+  if ( ! fVoxelPhantom ) {
+    G4PVPlacement* physPhantom4 = new G4PVPlacement(0,                              // Sin rotación 
+        phantom2Position,                // Posición detrás del plomo 
+        phantom2LV,                      // Volumen lógico del phantom 
+        "phantomPV",                    // Nombre del volumen físico del phantom 
+        worldLog,                       // Volumen madre (world) 
+        false,                          // No usar operación booleana 
+        0,                              // Número de copia
+        fCheckOverlaps);                // Chequear superposiciones
+
+    if ( fHoleMode == HoleMode::kDaughters && ! fStlMeshes[1] ) {
+      PlaceHole(airRectangle, phantom2LV, G4ThreeVector(0.0, kSlotOffsetY, 0.0), holeMaterial);
+      PlaceHole(airRectangle2, phantom2LV, G4ThreeVector(), holeMaterial);
+      PlaceHole(airRectangle3, phantom2LV, G4ThreeVector(0.0, -kSlotOffsetY, 0.0), holeMaterial);
+    }
+  }
+
+  //
+  // Optional voxelised phantom, against the back face of the lead
+  //
+  G4double phantomCenterZ = phantom4PosZ;
+  std::vector<G4LogicalVolume*> phantomLVs { phantomLV, phantom2LV };
+  if ( fVoxelPhantom ) {
+    phantomLVs = { PlaceVoxelPhantom(worldLog, plomo_hz) };
+    phantomCenterZ = plomo_hz + fVoxelPhantom->GetHalfSize().z();
+  }
 
 
 
@@ -630,9 +787,9 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
   // Creo el detector:
   // 
-  G4double detector_hx = 6.0 * cm;
-  G4double detector_hy = 6.0 * cm;
-  G4double detector_hz = 0.1 * m;
+  G4double detector_hx = kDetectorHalfXY;
+  G4double detector_hy = kDetectorHalfXY;
+  G4double detector_hz = kDetectorHalfZ;
 
   G4Box* detectorBox = new G4Box("Detector", detector_hx, detector_hy, detector_hz);
   G4LogicalVolume* detectorLog
@@ -642,7 +799,17 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
   //Coloco el detector justo detrás de el cilindro
   G4double detectorPos_x = 0.0 * cm;
   G4double detectorPos_y = 0.0 * cm;
-  G4double detectorPos_z = phantom4PosZ+11.0 * cm;
+  G4double detectorDistance = fDetectorDistance;
+  if ( fVoxelPhantom &&
+       detectorDistance <= fVoxelPhantom->GetHalfSize().z() + detector_hz ) {
+    detectorDistance = fVoxelPhantom->GetHalfSize().z() + detector_hz;
+    G4ExceptionDescription msg;
+    msg << "The detector would overlap the voxel phantom; it is placed "
+        << detectorDistance / cm << " cm from the phantom center.";
+    G4Exception("DetectorConstruction::DefineVolumes()",
+      "MyCode0016", JustWarning, msg);
+  }
+  G4double detectorPos_z = phantomCenterZ + detectorDistance;
 
   //Volumen fisico del detector:
   //
@@ -656,6 +823,35 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
           false,                   // no boolean operations
           0);                      // its copy number
 
+  // Pixelated detector: columns replicated along x, each of them
+  // filled with pixels replicated along y; the replica numbers of
+  // a pixel and of its column give the pixel index
+  //
+  fDetectorSensitiveLV = detectorLog;
+  if ( fDetectorPixels[0] > 0 ) {
+    auto nx = fDetectorPixels[0];
+    auto ny = fDetectorPixels[1];
+
+    auto columnBox
+      = new G4Box("DetectorColumn", detector_hx / nx, detector_hy, detector_hz);
+    auto columnLog
+      = new G4LogicalVolume(columnBox, detectorMaterial, "DetectorColumn");
+    new G4PVReplica("DetectorColumn", columnLog, detectorLog,
+                    kXAxis, nx, 2. * detector_hx / nx);
+
+    auto pixelBox
+      = new G4Box("DetectorPixel", detector_hx / nx, detector_hy / ny, detector_hz);
+    auto pixelLog
+      = new G4LogicalVolume(pixelBox, detectorMaterial, "DetectorPixel");
+    new G4PVReplica("DetectorPixel", pixelLog, columnLog,
+                    kYAxis, ny, 2. * detector_hy / ny);
+
+    columnLog->SetVisAttributes(G4VisAttributes::GetInvisible());
+    pixelLog->SetVisAttributes(G4VisAttributes::GetInvisible());
+    fDetectorSensitiveLV = pixelLog;
+  }
+
+
 
 
 
@@ -665,6 +861,20 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
 
 
+  //
+  // Kill zones, placed around the volumes above
+  //
+  ComputeTargetBox(worldLog);
+  PlaceKillZones(worldLog, G4ThreeVector(world_hx, world_hy, world_hz));
+  PlacePhaseSpacePlane(worldLog, G4ThreeVector(world_hx, world_hy, world_hz));
+
+  //
+  // Regions with their own production cuts and user limits
+  //
+  DefineRegion("Lead", { plomoLV });
+  DefineRegion("Phantoms", phantomLVs);
+  DefineRegion("Detector", { detectorLog });
+
 
   worldLog->SetVisAttributes(G4VisAttributes::GetInvisible()); 
   //detectorLog->SetVisAttributes(G4VisAttributes::GetInvisible());
@@ -696,28 +906,6 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
     DetectorVisAtt->SetVisibility(true);
     detectorLog->SetVisAttributes(DetectorVisAtt);
 
-    /*
-    //"Blindajes" de PE
-    G4VisAttributes* polietilenoBigVisAtt = new G4VisAttributes(G4Colour(1.0, 0.0, 1.0)); // Azul claritoB
-    polietilenoBigVisAtt->SetVisibility(true);
-    polietilenoBigLV->SetVisAttributes(polietilenoBigVisAtt);
-
-    G4VisAttributes* solidInnerBoxVisAtt = new G4VisAttributes(G4Colour(1.0, 0.0, 1.0)); // Azul claritoB
-    solidInnerBoxVisAtt->SetVisibility(true);
-    solidInnerBoxLV->SetVisAttributes(solidInnerBoxVisAtt);
-
-    G4VisAttributes* solidUpperBoxVisAtt = new G4VisAttributes(G4Colour(1.0, 0.0, 1.0)); // Azul claritoB
-    solidUpperBoxVisAtt->SetVisibility(true);
-    solidUpperBoxLV->SetVisAttributes(solidUpperBoxVisAtt);
-
-    G4VisAttributes* polietilenoVisAtt = new G4VisAttributes(G4Colour(1.0, 1.0, 0.0)); // Azul claritoB
-    polietilenoVisAtt->SetVisibility(true);
-    polietilenoLV->SetVisAttributes(polietilenoVisAtt);
-
-    G4VisAttributes* colimadorVisAtt = new G4VisAttributes(G4Colour(1.0, 1.0, 0.0)); // Azul claritoB
-    colimadorVisAtt->SetVisibility(true);
-    colimadorLV->SetVisAttributes(colimadorVisAtt);
-    */
 
   //
   // Always return the physical World
@@ -727,11 +915,793 @@ G4VPhysicalVolume* DetectorConstruction::DefineVolumes()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void DetectorConstruction::DefineRegion(
+  const G4String& regionName, const std::vector<G4LogicalVolume*>& volumes)
+{
+  auto region = G4RegionStore::GetInstance()->FindOrCreateRegion(regionName);
+  for ( auto volume : volumes ) {
+    region->AddRootLogicalVolume(volume);
+  }
+
+  // the user limits are attached to the root volumes,
+  // where they are applied by G4UserSpecialCuts
+  auto& settings = fRegionSettings[regionName];
+  if ( ! settings.fUserLimits ) {
+    settings.fUserLimits = new G4UserLimits();
+  }
+  for ( auto volume : volumes ) {
+    volume->SetUserLimits(settings.fUserLimits);
+  }
+
+  UpdateRegion(regionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::UpdateRegion(const G4String& regionName)
+{
+  auto& settings = fRegionSettings[regionName];
+  if ( settings.fUserLimits ) {
+    settings.fUserLimits->SetUserMinEkine(settings.fMinKineticEnergy);
+    settings.fUserLimits->SetUserMaxTime(settings.fMaxTime);
+  }
+
+  // without a cut set, the region uses the default production cuts
+  auto region = G4RegionStore::GetInstance()->GetRegion(regionName, false);
+  if ( region && settings.fCut >= 0. ) {
+    auto defaultCuts
+      = G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+    auto cuts = region->GetProductionCuts();
+    if ( ! cuts || cuts == defaultCuts ) {
+      cuts = new G4ProductionCuts();
+      region->SetProductionCuts(cuts);
+    }
+    cuts->SetProductionCut(settings.fCut);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetRegionCut(const G4String& regionName, G4double cut)
+{
+  fRegionSettings[regionName].fCut = cut;
+  UpdateRegion(regionName);
+
+  // the physics tables are rebuilt for the new cut at the next run
+  G4RunManager::GetRunManager()->PhysicsHasBeenModified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetRegionMinKineticEnergy(const G4String& regionName,
+                                                     G4double ekin)
+{
+  fRegionSettings[regionName].fMinKineticEnergy = ekin;
+  UpdateRegion(regionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetRegionMaxTime(const G4String& regionName,
+                                            G4double time)
+{
+  fRegionSettings[regionName].fMaxTime = time;
+  UpdateRegion(regionName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool DetectorConstruction::AddKillBox(const G4String& name,
+                                      const G4ThreeVector& center,
+                                      const G4ThreeVector& halfSize)
+{
+  for ( const auto& zone : fKillZones ) {
+    if ( zone.fName == name ) {
+      G4ExceptionDescription msg;
+      msg << "Kill zone " << name << " is already defined." << G4endl;
+      msg << "The command is ignored.";
+      G4Exception("DetectorConstruction::AddKillBox()",
+        "MyCode0010", JustWarning, msg);
+      return false;
+    }
+  }
+
+  fKillZones.push_back({ name, center, halfSize, false });
+  GeometryHasChanged();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::AddKillPlane(const G4String& name, G4double z)
+{
+  // the x, y extent is set to the world size in PlaceKillZones()
+  const G4double halfThickness = 0.5 * mm;
+  if ( AddKillBox(name, G4ThreeVector(0., 0., z),
+                  G4ThreeVector(0., 0., halfThickness)) ) {
+    fKillZones.back().fIsPlane = true;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::ClearKillZones()
+{
+  fKillZones.clear();
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::ComputeTargetBox(const G4LogicalVolume* worldLog)
+{
+  // Union of the bounding boxes of the world daughters, in the world frame
+  fTargetMin = G4ThreeVector(DBL_MAX, DBL_MAX, DBL_MAX);
+  fTargetMax = -fTargetMin;
+
+  for ( std::size_t i = 0; i < worldLog->GetNoDaughters(); ++i ) {
+    auto daughter = worldLog->GetDaughter(i);
+    G4ThreeVector pMin, pMax;
+    daughter->GetLogicalVolume()->GetSolid()->BoundingLimits(pMin, pMax);
+
+    auto rotation = daughter->GetObjectRotationValue();
+    auto translation = daughter->GetObjectTranslation();
+    for ( G4int corner = 0; corner < 8; ++corner ) {
+      G4ThreeVector point((corner & 1) ? pMax.x() : pMin.x(),
+                          (corner & 2) ? pMax.y() : pMin.y(),
+                          (corner & 4) ? pMax.z() : pMin.z());
+      point = rotation * point + translation;
+      fTargetMin.set(std::min(fTargetMin.x(), point.x()),
+                     std::min(fTargetMin.y(), point.y()),
+                     std::min(fTargetMin.z(), point.z()));
+      fTargetMax.set(std::max(fTargetMax.x(), point.x()),
+                     std::max(fTargetMax.y(), point.y()),
+                     std::max(fTargetMax.z(), point.z()));
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::PlaceKillZones(G4LogicalVolume* worldLog,
+                                          const G4ThreeVector& worldHalfSize)
+{
+  fKillZoneLVs.clear();
+  if ( fKillZones.empty() ) return;
+
+  auto worldMaterial = worldLog->GetMaterial();
+  for ( const auto& zone : fKillZones ) {
+    auto halfSize = zone.fHalfSize;
+    if ( zone.fIsPlane ) {
+      halfSize.setX(worldHalfSize.x());
+      halfSize.setY(worldHalfSize.y());
+    }
+
+    auto name = "KillZone_" + zone.fName;
+    auto killZoneBox = new G4Box(name, halfSize.x(), halfSize.y(), halfSize.z());
+    auto killZoneLV = new G4LogicalVolume(killZoneBox, worldMaterial, name);
+    new G4PVPlacement(nullptr,          // no rotation
+                      zone.fCenter,     // its position
+                      killZoneLV,       // its logical volume
+                      name,             // its name
+                      worldLog,         // its mother  volume
+                      false,            // no boolean operation
+                      0,                // copy number
+                      fCheckOverlaps);  // checking overlaps
+
+    killZoneLV->SetVisAttributes(G4VisAttributes::GetInvisible());
+    fKillZoneLVs.push_back(killZoneLV);
+  }
+
+  G4cout
+    << "--> " << fKillZones.size() << " kill zone(s) placed; target box "
+    << fTargetMin / cm << " - " << fTargetMax / cm << " cm" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::PlacePhaseSpacePlane(G4LogicalVolume* worldLog,
+                                                const G4ThreeVector& worldHalfSize)
+{
+  fPhaseSpacePlaneLV = nullptr;
+  if ( ! fPhaseSpacePlaneEnabled ) return;
+
+  const G4double halfThickness = 0.5 * mm;
+  auto planeBox = new G4Box("PhaseSpacePlane",
+                            worldHalfSize.x(), worldHalfSize.y(), halfThickness);
+  fPhaseSpacePlaneLV
+    = new G4LogicalVolume(planeBox, worldLog->GetMaterial(), "PhaseSpacePlane");
+  new G4PVPlacement(nullptr,                                   // no rotation
+                    G4ThreeVector(0., 0., fPhaseSpacePlaneZ),  // its position
+                    fPhaseSpacePlaneLV,                        // its logical volume
+                    "PhaseSpacePlane",                         // its name
+                    worldLog,                                  // its mother  volume
+                    false,                                     // no boolean operation
+                    0,                                         // copy number
+                    fCheckOverlaps);                           // checking overlaps
+
+  fPhaseSpacePlaneLV->SetVisAttributes(G4VisAttributes::GetInvisible());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::PlaceHole(G4VSolid* solid, G4LogicalVolume* motherLV,
+                                     const G4ThreeVector& position,
+                                     G4Material* material)
+{
+  // The hole is a daughter of the volume it is cut in: the navigator
+  // then locates it via the mother's smart voxels instead of computing
+  // distances to the whole subtraction chain
+  auto holeLV = new G4LogicalVolume(solid, material, solid->GetName() + "LV");
+  new G4PVPlacement(nullptr,                     // no rotation
+                    position,                    // its position
+                    holeLV,                      // its logical volume
+                    solid->GetName() + "PV",     // its name
+                    motherLV,                    // its mother  volume
+                    false,                       // no boolean operation
+                    0,                           // copy number
+                    fCheckOverlaps);             // checking overlaps
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4LogicalVolume* DetectorConstruction::PlaceVoxelPhantom(
+  G4LogicalVolume* worldLog, G4double leadHalfZ)
+{
+  // Materials, by the names defined above or NIST names
+  std::vector<G4Material*> materials;
+  for ( const auto& name : fVoxelPhantom->GetMaterialNames() ) {
+    auto material = G4Material::GetMaterial(name, false);
+    if ( ! material ) {
+      material = G4NistManager::Instance()->FindOrBuildMaterial(name);
+    }
+    if ( ! material ) {
+      G4ExceptionDescription msg;
+      msg << "Unknown material " << name << " in voxel phantom "
+          << fVoxelPhantom->GetFileName() << ".";
+      G4Exception("DetectorConstruction::PlaceVoxelPhantom()",
+        "MyCode0016", FatalException, msg);
+    }
+    materials.push_back(material);
+  }
+
+  auto halfSize = fVoxelPhantom->GetHalfSize();
+  auto voxelHalfSize = fVoxelPhantom->GetVoxelHalfSize();
+
+  // Container box, filled with the voxels
+  auto containerBox
+    = new G4Box("VoxelContainer", halfSize.x(), halfSize.y(), halfSize.z());
+  auto containerLV
+    = new G4LogicalVolume(containerBox, worldLog->GetMaterial(), "VoxelContainer");
+  auto containerPV
+    = new G4PVPlacement(nullptr,                                   // no rotation
+                        G4ThreeVector(0., 0., leadHalfZ + halfSize.z()),
+                        containerLV,                               // its logical volume
+                        "VoxelContainer",                          // its name
+                        worldLog,                                  // its mother  volume
+                        false,                                     // no boolean operation
+                        0,                                         // copy number
+                        fCheckOverlaps);                           // checking overlaps
+
+  // Voxels
+  auto parameterisation = new G4PhantomParameterisation();
+  parameterisation->SetVoxelDimensions(
+    voxelHalfSize.x(), voxelHalfSize.y(), voxelHalfSize.z());
+  parameterisation->SetNoVoxels(fVoxelPhantom->GetNofVoxelsX(),
+                                fVoxelPhantom->GetNofVoxelsY(),
+                                fVoxelPhantom->GetNofVoxelsZ());
+  parameterisation->SetMaterials(materials);
+  parameterisation->SetMaterialIndices(fVoxelPhantom->GetMaterialIndices());
+  parameterisation->BuildContainerSolid(containerPV);
+  parameterisation->CheckVoxelsFillContainer(
+    halfSize.x(), halfSize.y(), halfSize.z());
+  // the boundaries between voxels of the same material do not limit the steps
+  parameterisation->SetSkipEqualMaterials(true);
+
+  auto voxelBox = new G4Box("Voxel",
+                            voxelHalfSize.x(), voxelHalfSize.y(), voxelHalfSize.z());
+  auto voxelLV = new G4LogicalVolume(voxelBox, materials[0], "Voxel");
+  voxelLV->SetVisAttributes(G4VisAttributes::GetInvisible());
+
+  auto voxelPV
+    = new G4PVParameterised("Voxels",                          // its name
+                            voxelLV,                           // its logical volume
+                            containerLV,                       // its mother volume
+                            kUndefined,                        // no replication axis
+                            static_cast<G4int>(fVoxelPhantom->GetNofVoxels()),
+                            parameterisation);                 // its parameterisation
+  // navigate the voxels with G4RegularNavigation
+  voxelPV->SetRegularStructureId(1);
+
+  return containerLV;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VSolid* DetectorConstruction::BuildStlSolid(const G4String& name,
+                                              const StlMesh& mesh,
+                                              G4ThreeVector& position)
+{
+  G4Timer timer;
+  timer.Start();
+
+  auto solid = new G4TessellatedSolid(name);
+  if ( fStlMaxVoxels > 0 ) solid->SetMaxVoxels(fStlMaxVoxels);
+
+  std::size_t nofSkippedFacets = 0;
+  for ( std::size_t i = 0; i < mesh.GetNofFacets(); ++i ) {
+    auto facet = new G4TriangularFacet(mesh.GetVertex(i, 0),
+                                       mesh.GetVertex(i, 1),
+                                       mesh.GetVertex(i, 2), ABSOLUTE);
+    // degenerate facets (zero area) are dropped
+    if ( ! facet->IsDefined() ) {
+      delete facet;
+      ++nofSkippedFacets;
+      continue;
+    }
+    solid->AddFacet(facet);
+  }
+  timer.Stop();
+  auto facetTime = timer.GetRealElapsed();
+
+  // Closing the solid builds the vertex list and the facet voxels
+  timer.Start();
+  solid->SetSolidClosed(true);
+  timer.Stop();
+  auto voxelTime = timer.GetRealElapsed();
+
+  // The mesh is centred in x and y on the position of the phantom it
+  // replaces, with its front face at the phantom front face
+  G4ThreeVector pMin, pMax;
+  mesh.GetBoundingLimits(pMin, pMax);
+  position -= G4ThreeVector(0.5 * (pMin.x() + pMax.x()),
+                            0.5 * (pMin.y() + pMax.y()),
+                            pMin.z() + kPhantomHalfZ);
+
+  G4cout
+    << "--> STL solid " << name << " from " << mesh.GetFileName() << ": "
+    << solid->GetNumberOfFacets() << " facets";
+  if ( nofSkippedFacets > 0 ) {
+    G4cout << " (" << nofSkippedFacets << " degenerate facets dropped)";
+  }
+  G4cout
+    << G4endl
+    << "    read " << mesh.GetReadTime() << " s, facets "
+    << facetTime << " s, voxelisation " << voxelTime << " s" << G4endl
+    << "    " << solid->GetVoxels().GetCountOfVoxels() << " voxels, memory "
+    << solid->AllocatedMemory() / 1024 << " kB ("
+    << solid->AllocatedMemoryWithoutVoxels() / 1024 << " kB without voxels)"
+    << G4endl;
+
+  return solid;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetStlPhantom(const G4String& phantom,
+                                         const G4String& fileName,
+                                         G4double unit)
+{
+  if ( phantom != "PLA" && phantom != "teflon" ) {
+    G4ExceptionDescription msg;
+    msg << "Unknown phantom " << phantom << ", PLA or teflon expected."
+        << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetStlPhantom()",
+      "MyCode0017", JustWarning, msg);
+    return;
+  }
+
+  std::size_t index = ( phantom == "PLA" ) ? 0 : 1;
+  if ( fileName == "none" ) {
+    fStlMeshes[index].reset();
+  }
+  else {
+    auto mesh = std::make_unique<StlMesh>();
+    if ( ! mesh->Load(fileName, unit) ) return;
+    fStlMeshes[index] = std::move(mesh);
+  }
+
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetStlMaxVoxels(G4int maxVoxels)
+{
+  fStlMaxVoxels = maxVoxels;
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetOverlapCheckMode(const G4String& mode)
+{
+  if ( mode == "always" ) {
+    fOverlapCheckMode = OverlapCheckMode::kAlways;
+  }
+  else if ( mode == "cached" ) {
+    fOverlapCheckMode = OverlapCheckMode::kCached;
+  }
+  else if ( mode == "never" ) {
+    fOverlapCheckMode = OverlapCheckMode::kNever;
+  }
+  else {
+    G4ExceptionDescription msg;
+    msg << "Unknown overlap check mode " << mode << "." << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetOverlapCheckMode()",
+      "MyCode0018", JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetOverlapCacheFile(const G4String& fileName)
+{
+  fOverlapCache.SetFileName(fileName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetVoxelPhantom(const G4String& fileName)
+{
+  if ( fileName == "none" ) {
+    fVoxelPhantom.reset();
+  }
+  else {
+    auto voxelPhantom = std::make_unique<VoxelPhantom>();
+    if ( ! voxelPhantom->Load(fileName) ) return;
+    fVoxelPhantom = std::move(voxelPhantom);
+  }
+
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetModeratorEnabled(G4bool value)
+{
+  fModeratorEnabled = value;
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetPhaseSpacePlane(G4double z)
+{
+  fPhaseSpacePlaneEnabled = true;
+  fPhaseSpacePlaneZ = z;
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetHoleMode(const G4String& mode)
+{
+  if ( mode == "boolean" ) {
+    fHoleMode = HoleMode::kBoolean;
+  }
+  else if ( mode == "daughters" ) {
+    fHoleMode = HoleMode::kDaughters;
+  }
+  else {
+    G4ExceptionDescription msg;
+    msg << "Unknown hole representation " << mode << "." << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetHoleMode()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetLeadHalfThickness(G4double halfThickness)
+{
+  // the phantoms, and the detector behind them, are placed against the lead
+  if ( ! FitsInWorld(halfThickness, fDetectorDistance) ) {
+    G4ExceptionDescription msg;
+    msg << "With a lead half thickness of " << halfThickness / cm
+        << " cm, the lead or the detector would stick out of the world."
+        << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetLeadHalfThickness()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  fLeadHalfThickness = halfThickness;
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetLeadCutout(G4double halfX, G4double halfY)
+{
+  if ( halfX > kLeadHalfXY || halfY >= kLeadHalfXY ) {
+    G4ExceptionDescription msg;
+    msg << "The lead cutout " << halfX / cm << " x " << halfY / cm
+        << " cm (half sizes) does not fit in the lead." << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetLeadCutout()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  fLeadCutoutHalfSize.set(halfX, halfY);
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetHoleRadius(G4int hole, G4double radius)
+{
+  // the outer holes must stay inside the phantom, and the holes must not
+  // reach the next ones, so that they can also be placed as daughters
+  if ( hole < 0 || hole >= G4int(fHoleRadii.size()) || radius >= kPhantomHalfX ||
+       radius > kPhantomHalfY - kHoleOffsetY || radius > 0.5 * kHoleOffsetY ) {
+    G4ExceptionDescription msg;
+    msg << "Invalid PLA phantom hole " << hole << " radius "
+        << radius / cm << " cm." << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetHoleRadius()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  fHoleRadii[hole] = radius;
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetSlotHalfSize(G4int slot, G4double halfX,
+                                           G4double halfY)
+{
+  // the slots must stay inside the phantom, and must not reach the
+  // next ones
+  if ( slot < 0 || slot >= G4int(fSlotHalfSizes.size()) ||
+       halfX > kPhantomHalfX || halfY > 0.5 * kSlotOffsetY ||
+       halfY > kPhantomHalfY - kSlotOffsetY ) {
+    G4ExceptionDescription msg;
+    msg << "Invalid teflon phantom slot " << slot << " half sizes "
+        << halfX / cm << " x " << halfY / cm << " cm." << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetSlotHalfSize()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  fSlotHalfSizes[slot].set(halfX, halfY);
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetDetectorDistance(G4double distance)
+{
+  if ( distance <= kPhantomHalfZ + kDetectorHalfZ ) {
+    G4ExceptionDescription msg;
+    msg << "The detector at " << distance / cm
+        << " cm from the teflon phantom would overlap it." << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetDetectorDistance()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  if ( ! FitsInWorld(fLeadHalfThickness, distance) ) {
+    G4ExceptionDescription msg;
+    msg << "The detector at " << distance / cm
+        << " cm from the teflon phantom would stick out of the world."
+        << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetDetectorDistance()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  fDetectorDistance = distance;
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetDetectorPixels(G4int nx, G4int ny)
+{
+  if ( ( nx == 0 ) != ( ny == 0 ) ) {
+    G4ExceptionDescription msg;
+    msg << "Invalid detector segmentation " << nx << " x " << ny
+        << " pixels; use 0 0 for a single volume." << G4endl;
+    msg << "The command is ignored.";
+    G4Exception("DetectorConstruction::SetDetectorPixels()",
+      "MyCode0015", JustWarning, msg);
+    return;
+  }
+
+  fDetectorPixels = { nx, ny };
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetVolumeSmartless(const G4String& volumeName,
+                                              G4double smartless)
+{
+  fNavigationSettings[volumeName].fSmartless = smartless;
+  NavigationSettingsHaveChanged(volumeName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetVolumeOptimisation(const G4String& volumeName,
+                                                 G4bool optimise)
+{
+  fNavigationSettings[volumeName].fOptimise = optimise;
+  NavigationSettingsHaveChanged(volumeName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int DetectorConstruction::ApplyNavigationSettings() const
+{
+  G4int nofVolumes = 0;
+  if ( fNavigationSettings.empty() ) return nofVolumes;
+
+  for ( auto logicalVolume : *G4LogicalVolumeStore::GetInstance() ) {
+    auto it = fNavigationSettings.find(logicalVolume->GetName());
+    if ( it == fNavigationSettings.end() ) continue;
+
+    logicalVolume->SetSmartless(it->second.fSmartless);
+    logicalVolume->SetOptimisation(it->second.fOptimise);
+    ++nofVolumes;
+  }
+
+  return nofVolumes;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::NavigationSettingsHaveChanged(
+  const G4String& volumeName) const
+{
+  // before the geometry is built, the settings are applied in Construct()
+  if ( G4LogicalVolumeStore::GetInstance()->empty() ) return;
+
+  ApplyNavigationSettings();
+  if ( ! G4LogicalVolumeStore::GetInstance()->GetVolume(volumeName, false) ) {
+    G4ExceptionDescription msg;
+    msg << "There is no logical volume " << volumeName
+        << " in the current geometry;" << G4endl;
+    msg << "its voxel settings are kept for the next geometries.";
+    G4Exception("DetectorConstruction::NavigationSettingsHaveChanged()",
+      "MyCode0020", JustWarning, msg);
+    return;
+  }
+
+  // the voxels are rebuilt when the geometry is closed at the next run
+  G4RunManager::GetRunManager()->GeometryHasBeenModified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::RunNavigationBenchmark(G4int nofRays,
+                                                  G4double coneHalfAngle) const
+{
+  // the mass world, if the current geometry is built
+  auto world = G4TransportationManager::GetTransportationManager()
+                 ->GetNavigatorForTracking()->GetWorldVolume();
+  auto physicalVolumeStore = G4PhysicalVolumeStore::GetInstance();
+  if ( ! world ||
+       std::find(physicalVolumeStore->begin(), physicalVolumeStore->end(),
+                 world) == physicalVolumeStore->end() ) {
+    G4ExceptionDescription msg;
+    msg << "The geometry is not built; run /run/initialize first." << G4endl;
+    msg << "The benchmark is not run.";
+    G4Exception("DetectorConstruction::RunNavigationBenchmark()",
+      "MyCode0020", JustWarning, msg);
+    return;
+  }
+
+  NavigationBenchmark(kLeadHalfXY, coneHalfAngle).Run(world, nofRays);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::GeometryHasChanged()
+{
+  // the geometry is rebuilt at the next run; before the initialization
+  // it is simply built with the new parameters.
+  // It is destroyed first, so that the parallel worlds (importance and
+  // scoring worlds) are rebuilt on the new mass world as well
+  G4RunManager::GetRunManager()->ReinitializeGeometry(true);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool DetectorConstruction::FitsInWorld(G4double leadHalfThickness,
+                                         G4double detectorDistance) const
+{
+  // the same placement as in DefineVolumes(): the lead is centred at
+  // z = 0, the phantoms are against its back face and the detector is
+  // placed at the given distance from the phantom center
+  auto phantomHalfZ = kPhantomHalfZ;
+  if ( fVoxelPhantom ) {
+    phantomHalfZ = fVoxelPhantom->GetHalfSize().z();
+    detectorDistance
+      = std::max(detectorDistance, phantomHalfZ + kDetectorHalfZ);
+  }
+  auto detectorBackZ = leadHalfThickness + phantomHalfZ + detectorDistance
+                       + kDetectorHalfZ;
+
+  return leadHalfThickness < kWorldHalfSize && detectorBackZ <= kWorldHalfSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String DetectorConstruction::GetRegionNames()
+{
+  return "Lead Phantoms Detector";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void DetectorConstruction::ConstructSDandField()
 {
-  // Create global magnetic field messenger.
+  // Sensitive detector for the NaI detector:
+  // the scoring code runs only for steps inside the "Detector" volume,
+  // or inside its pixels when it is pixelated
+  //
+  // When the geometry is rebuilt, this function is called again:
+  // the sensitive detectors created at the first call are attached
+  // to the new volumes.
+  //
+  auto sdManager = G4SDManager::GetSDMpointer();
+  sdManager->SetVerboseLevel(1);
+  auto detectorSD = static_cast<B4a::DetectorSD*>(
+    sdManager->FindSensitiveDetector("DetectorSD", false));
+  if ( ! detectorSD ) {
+    detectorSD = new B4a::DetectorSD("DetectorSD", "DetectorHitsCollection");
+    sdManager->AddNewDetector(detectorSD);
+  }
+  detectorSD->SetPixelLayout(fDetectorPixels[0], fDetectorPixels[1],
+                             kDetectorHalfXY, kDetectorHalfXY);
+  SetSensitiveDetector(fDetectorSensitiveLV, detectorSD);
+
+  // Sensitive detector for the kill zones
+  //
+  if ( ! fKillZoneLVs.empty() ) {
+    auto killZoneSD = static_cast<B4a::KillZoneSD*>(
+      sdManager->FindSensitiveDetector("KillZoneSD", false));
+    if ( ! killZoneSD ) {
+      killZoneSD = new B4a::KillZoneSD("KillZoneSD");
+      sdManager->AddNewDetector(killZoneSD);
+    }
+    killZoneSD->SetTargetBox(fTargetMin, fTargetMax);
+    for ( auto killZoneLV : fKillZoneLVs ) {
+      SetSensitiveDetector(killZoneLV, killZoneSD);
+    }
+  }
+
+  // Sensitive detector for the phase space plane
+  //
+  if ( fPhaseSpacePlaneLV ) {
+    auto phaseSpaceSD = sdManager->FindSensitiveDetector("PhaseSpaceSD", false);
+    if ( ! phaseSpaceSD ) {
+      phaseSpaceSD = new B4a::PhaseSpaceSD("PhaseSpaceSD");
+      sdManager->AddNewDetector(phaseSpaceSD);
+    }
+    SetSensitiveDetector(fPhaseSpacePlaneLV, phaseSpaceSD);
+  }
+
+  // Create global magnetic field messenger (only once).
   // Uniform magnetic field is then created automatically if
   // the field value is not zero.
+  if ( fMagFieldMessenger ) return;
+
   G4ThreeVector fieldValue;
   fMagFieldMessenger = new G4GlobalMagFieldMessenger(fieldValue);
   fMagFieldMessenger->SetVerboseLevel(1);
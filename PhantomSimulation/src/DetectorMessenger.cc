@@ -0,0 +1,565 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/DetectorMessenger.cc
+/// \brief Implementation of the B4::DetectorMessenger class
+
+#include "DetectorMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorMessenger::DetectorMessenger(DetectorConstruction* detConstruction)
+ : fDetConstruction(detConstruction)
+{
+  fPhantomDirectory = new G4UIdirectory("/phantom/");
+  fPhantomDirectory->SetGuidance("UI commands of the phantom simulation");
+
+  fRegionDirectory = new G4UIdirectory("/phantom/region/");
+  fRegionDirectory->SetGuidance("Production cuts and user limits per region");
+
+  fSetCutCmd
+    = CreateRegionCommand("setCut",
+                          "Set the production cut of the region.",
+                          "Length", "mm");
+  fSetMinEkinCmd
+    = CreateRegionCommand("setMinEkin",
+                          "Set the minimum kinetic energy of tracks in the "
+                          "region;\nslower tracks (of any particle type, "
+                          "neutrons included) are killed.",
+                          "Energy", "keV");
+  fSetMaxTimeCmd
+    = CreateRegionCommand("setMaxTime",
+                          "Set the maximum global time of tracks in the "
+                          "region;\nlater tracks are killed.",
+                          "Time", "ns");
+
+  fKillZoneDirectory = new G4UIdirectory("/phantom/killzone/");
+  fKillZoneDirectory->SetGuidance(
+    "Kill zones: vacuum volumes where the neutrons which cannot reach\n"
+    "the lead, the phantoms or the detector any more are killed");
+
+  fAddKillBoxCmd = new G4UIcommand("/phantom/killzone/addBox", this);
+  fAddKillBoxCmd->SetGuidance("Add a box kill zone.");
+  fAddKillBoxCmd->SetGuidance("It must not overlap any other volume.");
+  fAddKillBoxCmd->SetParameter(new G4UIparameter("name", 's', false));
+  for ( const auto& prmName : { "x", "y", "z" } ) {
+    fAddKillBoxCmd->SetParameter(new G4UIparameter(prmName, 'd', false));
+  }
+  for ( const auto& prmName : { "halfX", "halfY", "halfZ" } ) {
+    auto halfSizePrm = new G4UIparameter(prmName, 'd', false);
+    halfSizePrm->SetParameterRange((G4String(prmName) + ">0.").c_str());
+    fAddKillBoxCmd->SetParameter(halfSizePrm);
+  }
+  fAddKillBoxCmd->SetParameter(CreateUnitParameter("Length", "cm"));
+  fAddKillBoxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fAddKillBoxCmd->SetToBeBroadcasted(false);
+
+  fAddKillPlaneCmd = new G4UIcommand("/phantom/killzone/addPlane", this);
+  fAddKillPlaneCmd->SetGuidance(
+    "Add a 1 mm thick kill zone spanning the world in x and y at z.");
+  fAddKillPlaneCmd->SetParameter(new G4UIparameter("name", 's', false));
+  fAddKillPlaneCmd->SetParameter(new G4UIparameter("z", 'd', false));
+  fAddKillPlaneCmd->SetParameter(CreateUnitParameter("Length", "cm"));
+  fAddKillPlaneCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fAddKillPlaneCmd->SetToBeBroadcasted(false);
+
+  fClearKillZonesCmd = new G4UIcommand("/phantom/killzone/clear", this);
+  fClearKillZonesCmd->SetGuidance("Remove all kill zones.");
+  fClearKillZonesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fClearKillZonesCmd->SetToBeBroadcasted(false);
+
+  fGeometryDirectory = new G4UIdirectory("/phantom/geometry/");
+  fGeometryDirectory->SetGuidance("Geometry options");
+
+  fModeratorCmd = new G4UIcmdWithABool("/phantom/geometry/moderator", this);
+  fModeratorCmd->SetGuidance(
+    "Add the moderator, collimator and polyethylene shielding in front of\n"
+    "the lead (to produce a phase space file).");
+  fModeratorCmd->SetParameterName("enable", true);
+  fModeratorCmd->SetDefaultValue(true);
+  fModeratorCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fModeratorCmd->SetToBeBroadcasted(false);
+
+  fPhaseSpacePlaneCmd
+    = new G4UIcmdWithADoubleAndUnit("/phantom/geometry/phaseSpacePlane", this);
+  fPhaseSpacePlaneCmd->SetGuidance(
+    "Add the 1 mm thick phase space plane spanning the world at z;\n"
+    "the neutrons crossing it forward are written in the phase space file.");
+  fPhaseSpacePlaneCmd->SetParameterName("z", false);
+  fPhaseSpacePlaneCmd->SetUnitCategory("Length");
+  fPhaseSpacePlaneCmd->SetDefaultUnit("cm");
+  fPhaseSpacePlaneCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fPhaseSpacePlaneCmd->SetToBeBroadcasted(false);
+
+  fHoleModeCmd = new G4UIcmdWithAString("/phantom/geometry/holes", this);
+  fHoleModeCmd->SetGuidance(
+    "Select the representation of the phantom holes and the lead cutout:\n"
+    " boolean   - subtracted from the volumes (G4SubtractionSolid)\n"
+    " daughters - placed in the volumes as daughter volumes");
+  fHoleModeCmd->SetParameterName("mode", false);
+  fHoleModeCmd->SetCandidates("boolean daughters");
+  fHoleModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fHoleModeCmd->SetToBeBroadcasted(false);
+
+  fOverlapCheckCmd
+    = new G4UIcmdWithAString("/phantom/geometry/overlapCheck", this);
+  fOverlapCheckCmd->SetGuidance(
+    "Select when the volume overlaps are checked:\n"
+    " always - at each placement\n"
+    " cached - once the geometry is built, unless the same geometry is\n"
+    "          in the overlap cache file\n"
+    " never  - not checked");
+  fOverlapCheckCmd->SetGuidance("It applies when the geometry is next built.");
+  fOverlapCheckCmd->SetParameterName("mode", false);
+  fOverlapCheckCmd->SetCandidates("always cached never");
+  fOverlapCheckCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fOverlapCheckCmd->SetToBeBroadcasted(false);
+
+  fOverlapCacheFileCmd
+    = new G4UIcmdWithAString("/phantom/geometry/overlapCacheFile", this);
+  fOverlapCacheFileCmd->SetGuidance(
+    "Set the overlap cache file (default B4_overlaps.cache).");
+  fOverlapCacheFileCmd->SetParameterName("fileName", false);
+  fOverlapCacheFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fOverlapCacheFileCmd->SetToBeBroadcasted(false);
+
+  fVoxelPhantomCmd
+    = new G4UIcmdWithAString("/phantom/geometry/voxelPhantom", this);
+  fVoxelPhantomCmd->SetGuidance(
+    "Load a voxelised phantom from its header file; it replaces the PLA\n"
+    "and teflon phantoms. \"none\" restores them.");
+  fVoxelPhantomCmd->SetParameterName("fileName", false);
+  fVoxelPhantomCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fVoxelPhantomCmd->SetToBeBroadcasted(false);
+
+  fStlPhantomCmd = new G4UIcommand("/phantom/geometry/stlPhantom", this);
+  fStlPhantomCmd->SetGuidance(
+    "Replace the PLA or the teflon phantom by a solid of the same material\n"
+    "imported from a binary STL file, with the vertices in the given unit;\n"
+    "\"none\" restores the phantom.");
+  auto phantomPrm = new G4UIparameter("phantom", 's', false);
+  phantomPrm->SetParameterCandidates("PLA teflon");
+  fStlPhantomCmd->SetParameter(phantomPrm);
+  fStlPhantomCmd->SetParameter(new G4UIparameter("fileName", 's', false));
+  fStlPhantomCmd->SetParameter(CreateUnitParameter("Length", "mm"));
+  fStlPhantomCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fStlPhantomCmd->SetToBeBroadcasted(false);
+
+  fStlMaxVoxelsCmd
+    = new G4UIcmdWithAnInteger("/phantom/geometry/stlMaxVoxels", this);
+  fStlMaxVoxelsCmd->SetGuidance(
+    "Set the maximum number of facet voxels of the STL solids;\n"
+    "0 for the Geant4 default.");
+  fStlMaxVoxelsCmd->SetParameterName("maxVoxels", false);
+  fStlMaxVoxelsCmd->SetRange("maxVoxels>=0");
+  fStlMaxVoxelsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fStlMaxVoxelsCmd->SetToBeBroadcasted(false);
+
+  fLeadHalfThicknessCmd
+    = CreateLengthCommand("leadHalfThickness",
+                          "Set the half thickness of the lead plate;\n"
+                          "the phantoms stay against its back face, and the "
+                          "detector must stay in the world.");
+
+  fLeadCutoutCmd = new G4UIcommand("/phantom/geometry/leadCutout", this);
+  fLeadCutoutCmd->SetGuidance(
+    "Set the half sizes in x and y of the cutout at the +x edge of the lead.");
+  for ( const auto& prmName : { "halfX", "halfY" } ) {
+    auto halfSizePrm = new G4UIparameter(prmName, 'd', false);
+    halfSizePrm->SetParameterRange((G4String(prmName) + ">0.").c_str());
+    fLeadCutoutCmd->SetParameter(halfSizePrm);
+  }
+  fLeadCutoutCmd->SetParameter(CreateUnitParameter("Length", "cm"));
+  fLeadCutoutCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fLeadCutoutCmd->SetToBeBroadcasted(false);
+
+  fHoleRadiusCmd = new G4UIcommand("/phantom/geometry/holeRadius", this);
+  fHoleRadiusCmd->SetGuidance(
+    "Set the radius of an air hole of the PLA phantom (0 = top, 2 = bottom);\n"
+    "at most half the 17 mm pitch of the holes.");
+  auto holePrm = new G4UIparameter("hole", 'i', false);
+  holePrm->SetParameterCandidates("0 1 2");
+  fHoleRadiusCmd->SetParameter(holePrm);
+  auto radiusPrm = new G4UIparameter("radius", 'd', false);
+  radiusPrm->SetParameterRange("radius>0.");
+  fHoleRadiusCmd->SetParameter(radiusPrm);
+  fHoleRadiusCmd->SetParameter(CreateUnitParameter("Length", "cm"));
+  fHoleRadiusCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fHoleRadiusCmd->SetToBeBroadcasted(false);
+
+  fSlotHalfSizeCmd = new G4UIcommand("/phantom/geometry/slotHalfSize", this);
+  fSlotHalfSizeCmd->SetGuidance(
+    "Set the half sizes in x and y of an air slot of the teflon phantom\n"
+    "(0 = top, 2 = bottom); halfY is at most half the 15.5 mm pitch of "
+    "the slots.");
+  auto slotPrm = new G4UIparameter("slot", 'i', false);
+  slotPrm->SetParameterCandidates("0 1 2");
+  fSlotHalfSizeCmd->SetParameter(slotPrm);
+  for ( const auto& prmName : { "halfX", "halfY" } ) {
+    auto halfSizePrm = new G4UIparameter(prmName, 'd', false);
+    halfSizePrm->SetParameterRange((G4String(prmName) + ">0.").c_str());
+    fSlotHalfSizeCmd->SetParameter(halfSizePrm);
+  }
+  fSlotHalfSizeCmd->SetParameter(CreateUnitParameter("Length", "cm"));
+  fSlotHalfSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSlotHalfSizeCmd->SetToBeBroadcasted(false);
+
+  fDetectorDistanceCmd
+    = CreateLengthCommand("detectorDistance",
+                          "Set the distance from the teflon phantom center "
+                          "to the detector center;\nthe detector must stay "
+                          "in the world.");
+
+  fDetectorPixelsCmd
+    = new G4UIcommand("/phantom/geometry/detectorPixels", this);
+  fDetectorPixelsCmd->SetGuidance(
+    "Pixelate the detector in nx x ny replicated pixels;\n"
+    "0 0 for a single detector volume.");
+  for ( const auto& prmName : { "nx", "ny" } ) {
+    auto nofPixelsPrm = new G4UIparameter(prmName, 'i', false);
+    nofPixelsPrm->SetParameterRange((G4String(prmName) + ">=0").c_str());
+    fDetectorPixelsCmd->SetParameter(nofPixelsPrm);
+  }
+  fDetectorPixelsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fDetectorPixelsCmd->SetToBeBroadcasted(false);
+
+  fNavigationDirectory = new G4UIdirectory("/phantom/navigation/");
+  fNavigationDirectory->SetGuidance("Smart voxel settings and benchmark");
+
+  fSmartlessCmd = new G4UIcommand("/phantom/navigation/smartless", this);
+  fSmartlessCmd->SetGuidance(
+    "Set the smartless of the logical volume: the average number of voxel\n"
+    "slices per daughter (Geant4 default 2). The setting is kept for the\n"
+    "next geometries; the voxels are rebuilt at the next run.");
+  fSmartlessCmd->SetParameter(new G4UIparameter("volume", 's', false));
+  auto smartlessPrm = new G4UIparameter("smartless", 'd', false);
+  smartlessPrm->SetParameterRange("smartless>0.");
+  fSmartlessCmd->SetParameter(smartlessPrm);
+  fSmartlessCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSmartlessCmd->SetToBeBroadcasted(false);
+
+  fOptimiseCmd = new G4UIcommand("/phantom/navigation/optimise", this);
+  fOptimiseCmd->SetGuidance(
+    "Set whether the daughters of the logical volume are voxelised.\n"
+    "The setting is kept for the next geometries; the voxels are rebuilt\n"
+    "at the next run.");
+  fOptimiseCmd->SetParameter(new G4UIparameter("volume", 's', false));
+  auto optimisePrm = new G4UIparameter("optimise", 'b', true);
+  optimisePrm->SetDefaultValue("true");
+  fOptimiseCmd->SetParameter(optimisePrm);
+  fOptimiseCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fOptimiseCmd->SetToBeBroadcasted(false);
+
+  fBenchmarkCmd = new G4UIcommand("/phantom/navigation/benchmark", this);
+  fBenchmarkCmd->SetGuidance(
+    "Fire a fixed set of straight rays across the current geometry and\n"
+    "print the ComputeStep and LocateGlobalPointAndSetup times per volume.");
+  fBenchmarkCmd->SetGuidance(
+    "The rays start on the world front face, over the lead plate,\n"
+    "within a cone of the given half angle around the beam axis.");
+  auto nofRaysPrm = new G4UIparameter("nofRays", 'i', true);
+  nofRaysPrm->SetDefaultValue(10000);
+  nofRaysPrm->SetParameterRange("nofRays>0");
+  fBenchmarkCmd->SetParameter(nofRaysPrm);
+  auto anglePrm = new G4UIparameter("coneHalfAngle", 'd', true);
+  anglePrm->SetDefaultValue(10.);
+  anglePrm->SetParameterRange("coneHalfAngle>=0.");
+  fBenchmarkCmd->SetParameter(anglePrm);
+  fBenchmarkCmd->SetParameter(CreateUnitParameter("Angle", "deg"));
+  fBenchmarkCmd->AvailableForStates(G4State_Idle);
+  fBenchmarkCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorMessenger::~DetectorMessenger()
+{
+  delete fSetCutCmd;
+  delete fSetMinEkinCmd;
+  delete fSetMaxTimeCmd;
+  delete fAddKillBoxCmd;
+  delete fAddKillPlaneCmd;
+  delete fClearKillZonesCmd;
+  delete fKillZoneDirectory;
+  delete fModeratorCmd;
+  delete fPhaseSpacePlaneCmd;
+  delete fHoleModeCmd;
+  delete fOverlapCheckCmd;
+  delete fOverlapCacheFileCmd;
+  delete fVoxelPhantomCmd;
+  delete fStlPhantomCmd;
+  delete fStlMaxVoxelsCmd;
+  delete fLeadHalfThicknessCmd;
+  delete fLeadCutoutCmd;
+  delete fHoleRadiusCmd;
+  delete fSlotHalfSizeCmd;
+  delete fDetectorDistanceCmd;
+  delete fDetectorPixelsCmd;
+  delete fSmartlessCmd;
+  delete fOptimiseCmd;
+  delete fBenchmarkCmd;
+  delete fNavigationDirectory;
+  delete fGeometryDirectory;
+  delete fRegionDirectory;
+  delete fPhantomDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcommand*
+DetectorMessenger::CreateRegionCommand(const G4String& name,
+                                       const G4String& guidance,
+                                       const G4String& unitCategory,
+                                       const G4String& defaultUnit)
+{
+  auto command = new G4UIcommand(("/phantom/region/" + name).c_str(), this);
+  command->SetGuidance(guidance);
+
+  auto regionPrm = new G4UIparameter("region", 's', false);
+  regionPrm->SetParameterCandidates(
+    DetectorConstruction::GetRegionNames().c_str());
+  command->SetParameter(regionPrm);
+
+  auto valuePrm = new G4UIparameter("value", 'd', false);
+  valuePrm->SetParameterRange("value>=0.");
+  command->SetParameter(valuePrm);
+
+  command->SetParameter(CreateUnitParameter(unitCategory, defaultUnit));
+
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  command->SetToBeBroadcasted(false);
+
+  return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIcmdWithADoubleAndUnit*
+DetectorMessenger::CreateLengthCommand(const G4String& name,
+                                       const G4String& guidance)
+{
+  auto command
+    = new G4UIcmdWithADoubleAndUnit(("/phantom/geometry/" + name).c_str(), this);
+  command->SetGuidance(guidance);
+  command->SetGuidance("The geometry is rebuilt at the next run.");
+  command->SetParameterName("value", false);
+  command->SetRange("value>0.");
+  command->SetUnitCategory("Length");
+  command->SetDefaultUnit("cm");
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  command->SetToBeBroadcasted(false);
+
+  return command;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4UIparameter*
+DetectorMessenger::CreateUnitParameter(const G4String& unitCategory,
+                                       const G4String& defaultUnit) const
+{
+  auto unitPrm = new G4UIparameter("unit", 's', true);
+  unitPrm->SetDefaultUnit(defaultUnit);
+  unitPrm->SetParameterCandidates(
+    G4UIcommand::UnitsList(unitCategory).c_str());
+
+  return unitPrm;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if ( command == fSetCutCmd || command == fSetMinEkinCmd ||
+       command == fSetMaxTimeCmd ) {
+    G4String region, unit;
+    G4double value = 0.;
+    std::istringstream is(newValue);
+    is >> region >> value >> unit;
+    value *= G4UIcommand::ValueOf(unit);
+
+    if ( command == fSetCutCmd ) {
+      fDetConstruction->SetRegionCut(region, value);
+    }
+    else if ( command == fSetMinEkinCmd ) {
+      fDetConstruction->SetRegionMinKineticEnergy(region, value);
+    }
+    else {
+      fDetConstruction->SetRegionMaxTime(region, value);
+    }
+  }
+
+  if ( command == fAddKillBoxCmd ) {
+    G4String name, unit;
+    G4double x = 0., y = 0., z = 0., halfX = 0., halfY = 0., halfZ = 0.;
+    std::istringstream is(newValue);
+    is >> name >> x >> y >> z >> halfX >> halfY >> halfZ >> unit;
+    auto scale = G4UIcommand::ValueOf(unit);
+    fDetConstruction->AddKillBox(name,
+                                 G4ThreeVector(x, y, z) * scale,
+                                 G4ThreeVector(halfX, halfY, halfZ) * scale);
+  }
+
+  if ( command == fAddKillPlaneCmd ) {
+    G4String name, unit;
+    G4double z = 0.;
+    std::istringstream is(newValue);
+    is >> name >> z >> unit;
+    fDetConstruction->AddKillPlane(name, z * G4UIcommand::ValueOf(unit));
+  }
+
+  if ( command == fClearKillZonesCmd ) {
+    fDetConstruction->ClearKillZones();
+  }
+
+  if ( command == fModeratorCmd ) {
+    fDetConstruction->SetModeratorEnabled(
+      G4UIcmdWithABool::GetNewBoolValue(newValue));
+  }
+
+  if ( command == fPhaseSpacePlaneCmd ) {
+    fDetConstruction->SetPhaseSpacePlane(
+      G4UIcmdWithADoubleAndUnit::GetNewDoubleValue(newValue));
+  }
+
+  if ( command == fHoleModeCmd ) {
+    fDetConstruction->SetHoleMode(newValue);
+  }
+
+  if ( command == fOverlapCheckCmd ) {
+    fDetConstruction->SetOverlapCheckMode(newValue);
+  }
+
+  if ( command == fOverlapCacheFileCmd ) {
+    fDetConstruction->SetOverlapCacheFile(newValue);
+  }
+
+  if ( command == fVoxelPhantomCmd ) {
+    fDetConstruction->SetVoxelPhantom(newValue);
+  }
+
+  if ( command == fStlPhantomCmd ) {
+    G4String phantom, fileName, unit;
+    std::istringstream is(newValue);
+    is >> phantom >> fileName >> unit;
+    fDetConstruction->SetStlPhantom(phantom, fileName,
+                                    G4UIcommand::ValueOf(unit));
+  }
+
+  if ( command == fStlMaxVoxelsCmd ) {
+    fDetConstruction->SetStlMaxVoxels(
+      G4UIcmdWithAnInteger::GetNewIntValue(newValue));
+  }
+
+  if ( command == fLeadHalfThicknessCmd ) {
+    fDetConstruction->SetLeadHalfThickness(
+      G4UIcmdWithADoubleAndUnit::GetNewDoubleValue(newValue));
+  }
+
+  if ( command == fLeadCutoutCmd ) {
+    G4String unit;
+    G4double halfX = 0., halfY = 0.;
+    std::istringstream is(newValue);
+    is >> halfX >> halfY >> unit;
+    auto scale = G4UIcommand::ValueOf(unit);
+    fDetConstruction->SetLeadCutout(halfX * scale, halfY * scale);
+  }
+
+  if ( command == fHoleRadiusCmd ) {
+    G4String unit;
+    G4int hole = 0;
+    G4double radius = 0.;
+    std::istringstream is(newValue);
+    is >> hole >> radius >> unit;
+    fDetConstruction->SetHoleRadius(hole, radius * G4UIcommand::ValueOf(unit));
+  }
+
+  if ( command == fSlotHalfSizeCmd ) {
+    G4String unit;
+    G4int slot = 0;
+    G4double halfX = 0., halfY = 0.;
+    std::istringstream is(newValue);
+    is >> slot >> halfX >> halfY >> unit;
+    auto scale = G4UIcommand::ValueOf(unit);
+    fDetConstruction->SetSlotHalfSize(slot, halfX * scale, halfY * scale);
+  }
+
+  if ( command == fDetectorDistanceCmd ) {
+    fDetConstruction->SetDetectorDistance(
+      G4UIcmdWithADoubleAndUnit::GetNewDoubleValue(newValue));
+  }
+
+  if ( command == fDetectorPixelsCmd ) {
+    G4int nx = 0, ny = 0;
+    std::istringstream is(newValue);
+    is >> nx >> ny;
+    fDetConstruction->SetDetectorPixels(nx, ny);
+  }
+
+  if ( command == fSmartlessCmd ) {
+    G4String volumeName;
+    G4double smartless = 0.;
+    std::istringstream is(newValue);
+    is >> volumeName >> smartless;
+    fDetConstruction->SetVolumeSmartless(volumeName, smartless);
+  }
+
+  if ( command == fOptimiseCmd ) {
+    G4String volumeName, optimise;
+    std::istringstream is(newValue);
+    is >> volumeName >> optimise;
+    fDetConstruction->SetVolumeOptimisation(
+      volumeName, G4UIcommand::ConvertToBool(optimise));
+  }
+
+  if ( command == fBenchmarkCmd ) {
+    G4String unit;
+    G4int nofRays = 0;
+    G4double coneHalfAngle = 0.;
+    std::istringstream is(newValue);
+    is >> nofRays >> coneHalfAngle >> unit;
+    fDetConstruction->RunNavigationBenchmark(
+      nofRays, coneHalfAngle * G4UIcommand::ValueOf(unit));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,383 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/DetectorSD.cc
+/// \brief Implementation of the B4a::DetectorSD class
+
+#include "DetectorSD.hh"
+
+#include "ImageAccumulable.hh"
+#include "ImageCubeAccumulable.hh"
+#include "PixelAccumulable.hh"
+#include "PrimaryInfo.hh"
+#include "TrackInformation.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4NavigationHistory.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4Neutron.hh"
+#include "G4SDManager.hh"
+#include "G4Step.hh"
+#include "G4VSolid.hh"
+#include "G4VTouchable.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <string>
+
+namespace B4a
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorSD::DetectorSD(const G4String& name,
+                       const G4String& hitsCollectionName)
+ : G4VSensitiveDetector(name)
+{
+  collectionName.insert(hitsCollectionName);
+
+  // Define commands for this class
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorSD::~DetectorSD()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorSD::Initialize(G4HCofThisEvent* hce)
+{
+  // Create hits collection
+  fHitsCollection
+    = new DetectorHitsCollection(SensitiveDetectorName, collectionName[0]);
+
+  // Add this collection in hce
+  auto hcID
+    = G4SDManager::GetSDMpointer()->GetCollectionID(collectionName[0]);
+  hce->AddHitsCollection( hcID, fHitsCollection );
+
+  // Create one hit for the detector totals of each primary
+  auto event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  auto nofPrimaries = event ? std::max(event->GetNumberOfPrimaryVertex(), 1) : 1;
+  for ( G4int i = 0; i < nofPrimaries; ++i ) {
+    fHitsCollection->insert(new DetectorHit());
+  }
+
+  // Get the thread local image accumulables (only once)
+  if ( ! fImage ) {
+    auto accumulableManager = G4AccumulableManager::Instance();
+    fImage = static_cast<B4::ImageAccumulable*>(
+      accumulableManager->GetAccumulable("h2"));
+    fCube = static_cast<B4::ImageCubeAccumulable*>(
+      accumulableManager->GetAccumulable("cube"));
+    fPixels = static_cast<B4::PixelAccumulable*>(
+      accumulableManager->GetAccumulable("pixels"));
+  }
+
+  // Allocate the pixel accumulable for the detector segmentation
+  // (it is released at the beginning of each run)
+  if ( fPixels && fNofPixelsX > 0 &&
+       ( ! fPixels->IsActive() || fPixels->GetNofPixelsX() != fNofPixelsX ||
+         fPixels->GetNofPixelsY() != fNofPixelsY ) ) {
+    fPixels->SetLayout(fNofPixelsX, fNofPixelsY, fDetectorHalfX, fDetectorHalfY);
+  }
+
+  // The pixel energies are summed per primary and pixel
+  // (the entries are zeroed after each event)
+  auto nofPixelSums = static_cast<std::size_t>(nofPrimaries)
+                      * fNofPixelsX * fNofPixelsY;
+  if ( fPixelEnergies.size() < nofPixelSums ) {
+    fPixelEnergies.resize(nofPixelSums, 0.);
+    fPixelWeightedEnergies.resize(nofPixelSums, 0.);
+  }
+
+  // Get the source energy (the image cube axis) and the image of
+  // the energy scan bin of each primary
+  fPrimaryEnergies.assign(nofPrimaries, 0.);
+  fPrimarySliceImages.assign(nofPrimaries, nullptr);
+  for ( G4int i = 0; event && i < event->GetNumberOfPrimaryVertex(); ++i ) {
+    auto primary = event->GetPrimaryVertex(i)->GetPrimary();
+    fPrimaryEnergies[i] = primary->GetKineticEnergy();
+    auto info = dynamic_cast<B4::PrimaryInfo*>(primary->GetUserInformation());
+    if ( ! info || info->GetEnergyBin() < 0 ) continue;
+
+    // the slice images are registered by the run action (only once)
+    auto bin = static_cast<std::size_t>(info->GetEnergyBin());
+    while ( fSliceImages.size() <= bin ) {
+      fSliceImages.push_back(static_cast<B4::ImageAccumulable*>(
+        G4AccumulableManager::Instance()->GetAccumulable(
+          "h2_" + std::to_string(fSliceImages.size()))));
+    }
+    fPrimarySliceImages[i] = fSliceImages[bin];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool DetectorSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  // statistical weight of the track (not 1 with biasing)
+  auto weight = step->GetPreStepPoint()->GetWeight();
+
+  // the primary the track descends from; the tracks are not tagged
+  // when the event has a single primary (slot 0)
+  auto info
+    = static_cast<TrackInformation*>(step->GetTrack()->GetUserInformation());
+  std::size_t slot = info ? static_cast<std::size_t>(info->GetPrimarySlot()) : 0;
+  if ( slot >= fHitsCollection->entries() ) slot = 0;
+  auto sliceImage = fPrimarySliceImages[slot];
+
+  // energy deposit
+  auto edep = step->GetTotalEnergyDeposit();
+
+  // step length (neutrons only)
+  auto isNeutron
+    = ( step->GetTrack()->GetDefinition() == G4Neutron::Definition() );
+  G4double stepLength = 0.;
+  if ( isNeutron ) {
+    stepLength = step->GetStepLength();
+
+    // neutron position in the detector; the cube is binned in the
+    // source energy of its primary, not in the local neutron energy
+    auto preStepPoint = step->GetPreStepPoint();
+    auto energy = fPrimaryEnergies[slot];
+    if ( fImagingMode == ImagingMode::kAllSteps ) {
+      FillImage(preStepPoint->GetPosition(), energy, weight, sliceImage);
+    }
+    else if ( IsDetectorEntry(preStepPoint) ) {
+      // the neutron has just crossed into the detector
+      if ( fProjectToFrontFace ) {
+        FillImage(ProjectToFrontFace(preStepPoint), energy, weight,
+                  sliceImage);
+      }
+      else {
+        FillImage(preStepPoint->GetPosition(), energy, weight, sliceImage);
+      }
+    }
+  }
+
+  // energy deposit in the pixel, from the replica numbers of the
+  // pixel (y) and of its column (x); x is reversed as in the h2 image;
+  // it is summed per primary, unweighted for the threshold and weighted
+  // for the mean weight of the deposits
+  if ( edep > 0. && fNofPixelsX > 0 ) {
+    auto touchable = step->GetPreStepPoint()->GetTouchable();
+    auto ix = fNofPixelsX - 1 - touchable->GetReplicaNumber(1);
+    auto iy = touchable->GetReplicaNumber(0);
+    auto pixel = static_cast<std::size_t>(iy) * fNofPixelsX + ix;
+    auto index = slot * fNofPixelsX * fNofPixelsY + pixel;
+    if ( fPixelEnergies[index] == 0. ) fHitPixels.push_back(index);
+    fPixelEnergies[index] += edep;
+    fPixelWeightedEnergies[index] += weight * edep;
+  }
+
+  if ( edep==0. && stepLength == 0. ) return false;
+
+  auto hit = (*fHitsCollection)[slot];
+  if ( ! hit ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot access hit in the detector hits collection";
+    G4Exception("DetectorSD::ProcessHits()",
+      "MyCode0004", FatalException, msg);
+  }
+
+  // Add weighted values
+  hit->Add(weight * edep, weight * stepLength);
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool DetectorSD::IsDetectorEntry(const G4StepPoint* point) const
+{
+  if ( point->GetStepStatus() != fGeomBoundary ) return false;
+  if ( fNofPixelsX == 0 ) return true;
+
+  // With pixels, the crossings between the pixel replicas are boundaries
+  // too: the neutron enters the detector only when the point is on the
+  // surface of the detector envelope, the mother of the pixel columns
+  const G4int depth = 2;
+  auto touchable = point->GetTouchable();
+  auto history = touchable->GetHistory();
+  const auto& transform = history->GetTransform(history->GetDepth() - depth);
+  auto localPosition = transform.TransformPoint(point->GetPosition());
+
+  return touchable->GetSolid(depth)->Inside(localPosition) == kSurface;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ThreeVector DetectorSD::ProjectToFrontFace(const G4StepPoint* point) const
+{
+  // Move the point along the neutron direction to the detector
+  // front face plane (the low z face in the detector frame)
+  auto touchable = point->GetTouchable();
+  const auto& transform = touchable->GetHistory()->GetTopTransform();
+
+  auto localPosition = transform.TransformPoint(point->GetPosition());
+  auto localDirection = transform.TransformAxis(point->GetMomentumDirection());
+
+  // a neutron moving parallel to the front face keeps its entry point
+  if ( localDirection.z() == 0. ) return point->GetPosition();
+
+  G4ThreeVector pMin, pMax;
+  touchable->GetSolid()->BoundingLimits(pMin, pMax);
+
+  auto distance = (pMin.z() - localPosition.z()) / localDirection.z();
+  localPosition += distance * localDirection;
+
+  return transform.InverseTransformPoint(localPosition);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorSD::FillImage(const G4ThreeVector& position, G4double energy,
+                           G4double weight,
+                           B4::ImageAccumulable* sliceImage)
+{
+  if ( fImage ) fImage->Fill(-position.x(), position.y(), weight);
+  if ( sliceImage ) sliceImage->Fill(-position.x(), position.y(), weight);
+  if ( fCube && fCube->IsActive() ) {
+    fCube->Fill(-position.x(), position.y(), energy, weight);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorSD::SetImagingMode(const G4String& mode)
+{
+  if ( mode == "allSteps" ) {
+    fImagingMode = ImagingMode::kAllSteps;
+  }
+  else if ( mode == "entry" ) {
+    fImagingMode = ImagingMode::kEntry;
+  }
+  else {
+    G4ExceptionDescription msg;
+    msg << "Unknown imaging mode " << mode << "." << G4endl;
+    msg << "The imaging mode was not changed.";
+    G4Exception("DetectorSD::SetImagingMode()",
+      "MyCode0005", JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorSD::SetPixelLayout(G4int nx, G4int ny,
+                                G4double halfX, G4double halfY)
+{
+  fNofPixelsX = nx;
+  fNofPixelsY = ny;
+  fDetectorHalfX = halfX;
+  fDetectorHalfY = halfY;
+  fPixelEnergies.assign(static_cast<std::size_t>(nx) * ny, 0.);
+  fPixelWeightedEnergies.assign(static_cast<std::size_t>(nx) * ny, 0.);
+  fHitPixels.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorSD::DefineCommands()
+{
+  // Define /phantom/image command directory using generic messenger class
+  fMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/image/",
+                             "Radiograph imaging control");
+
+  // mode command
+  auto& modeCmd
+    = fMessenger->DeclareMethod("mode",
+                                &DetectorSD::SetImagingMode,
+                                "Select which neutron steps fill h2:\n"
+                                " allSteps - every neutron step in the NaI\n"
+                                " entry    - once per neutron, at the entry point");
+  modeCmd.SetParameterName("mode", false);
+  modeCmd.SetCandidates("allSteps entry");
+  modeCmd.SetDefaultValue("allSteps");
+
+  // projectToFrontFace command
+  auto& projectCmd
+    = fMessenger->DeclareProperty("projectToFrontFace",
+                                  fProjectToFrontFace,
+                                  "In entry mode, project the entry point "
+                                  "onto the detector front face plane.");
+  projectCmd.SetParameterName("project", true);
+  projectCmd.SetDefaultValue("true");
+
+  // pixelThreshold command
+  auto& thresholdCmd
+    = fMessenger->DeclarePropertyWithUnit("pixelThreshold", "keV",
+                                          fPixelThreshold,
+                                          "Minimum energy of a pixel hit of one "
+                                          "primary (pixelated detector).");
+  thresholdCmd.SetParameterName("threshold", false);
+  thresholdCmd.SetRange("threshold>=0.");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorSD::EndOfEvent(G4HCofThisEvent*)
+{
+  // Fill the pixels above threshold, per primary, and reset them for the
+  // next event; the threshold applies to the physical energy, and the
+  // hit gets the mean weight of its deposits (the primary weight, unless
+  // the track was split)
+  auto nofPixels = static_cast<std::size_t>(fNofPixelsX) * fNofPixelsY;
+  for ( auto index : fHitPixels ) {
+    auto energy = fPixelEnergies[index];
+    if ( fPixels && energy > fPixelThreshold ) {
+      fPixels->Fill(index % nofPixels, energy,
+                    fPixelWeightedEnergies[index] / energy);
+    }
+    fPixelEnergies[index] = 0.;
+    fPixelWeightedEnergies[index] = 0.;
+  }
+  fHitPixels.clear();
+
+  if ( verboseLevel>1 ) {
+     auto nofHits = fHitsCollection->entries();
+     G4cout
+       << G4endl
+       << "-------->Hits Collection: in this event they are " << nofHits
+       << " hits in the NaI detector: " << G4endl;
+     for ( std::size_t i=0; i<nofHits; ++i ) (*fHitsCollection)[i]->Print();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
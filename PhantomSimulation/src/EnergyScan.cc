@@ -0,0 +1,231 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/EnergyScan.cc
+/// \brief Implementation of the B4::EnergyScan class
+
+#include "EnergyScan.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EnergyScan* EnergyScan::Instance()
+{
+  static EnergyScan instance;
+  return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EnergyScan::EnergyScan()
+{
+  // Define commands for this class
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+EnergyScan::~EnergyScan()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnergyScan::SetEnergies(const G4String& energies)
+{
+  // energies = "e1 e2 ... unit"
+  std::istringstream is(energies);
+  std::vector<G4String> tokens;
+  G4String token;
+  while ( is >> token ) tokens.push_back(token);
+
+  std::vector<G4double> values;
+  G4bool valid = ( tokens.size() >= 2 && G4UIcommand::ValueOf(tokens.back()) > 0. );
+  for ( std::size_t i = 0; valid && i + 1 < tokens.size(); ++i ) {
+    std::istringstream value(tokens[i]);
+    G4double energy = 0.;
+    valid = ( value >> energy ) && energy > 0.;
+    values.push_back(energy * G4UIcommand::ValueOf(tokens.back()));
+  }
+
+  if ( ! valid ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot read \"e1 e2 ... unit\" from \"" << energies << "\"." << G4endl;
+    msg << "The energy scan was not changed.";
+    G4Exception("EnergyScan::SetEnergies()",
+      "MyCode0014", JustWarning, msg);
+    return;
+  }
+
+  fEnergies = values;
+  fLogBins = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnergyScan::SetLogBins(const G4String& bins)
+{
+  // bins = "n emin emax unit"
+  std::istringstream is(bins);
+  G4int nbins = 0;
+  G4double emin = 0., emax = 0.;
+  G4String unit;
+  if ( ! ( is >> nbins >> emin >> emax >> unit ) ||
+       nbins < 1 || emin <= 0. || emax <= emin ||
+       G4UIcommand::ValueOf(unit) <= 0. ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot read \"n emin emax unit\" from \"" << bins << "\"." << G4endl;
+    msg << "The energy scan was not changed.";
+    G4Exception("EnergyScan::SetLogBins()",
+      "MyCode0014", JustWarning, msg);
+    return;
+  }
+
+  auto scale = G4UIcommand::ValueOf(unit);
+  fEnergies.clear();
+  for ( G4int i = 0; i <= nbins; ++i ) {
+    fEnergies.push_back(
+      emin * scale * std::pow(emax / emin, static_cast<G4double>(i) / nbins));
+  }
+  fLogBins = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnergyScan::SetSampling(const G4String& sampling)
+{
+  fSampling
+    = ( sampling == "random" ) ? Sampling::kRandom : Sampling::kRoundRobin;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnergyScan::Clear()
+{
+  fEnergies.clear();
+  fLogBins = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int EnergyScan::SelectBin(G4long primaryIndex) const
+{
+  auto nbins = GetNofBins();
+  if ( fSampling == Sampling::kRandom ) {
+    return std::min(static_cast<G4int>(G4UniformRand() * nbins), nbins - 1);
+  }
+  return static_cast<G4int>(primaryIndex % nbins);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double EnergyScan::SampleEnergy(G4int bin) const
+{
+  if ( ! fLogBins ) return fEnergies[bin];
+
+  // log uniform in the bin
+  return fEnergies[bin]
+         * std::pow(fEnergies[bin+1] / fEnergies[bin], G4UniformRand());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String EnergyScan::GetBinLabel(G4int bin) const
+{
+  std::ostringstream label;
+  if ( fLogBins ) {
+    label << G4BestUnit(fEnergies[bin], "Energy") << "- "
+          << G4BestUnit(fEnergies[bin+1], "Energy");
+  }
+  else {
+    label << G4BestUnit(fEnergies[bin], "Energy");
+  }
+  return label.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnergyScan::DefineCommands()
+{
+  // Define /phantom/scan command directory using generic messenger class
+  fMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/scan/",
+                             "Single run energy scan control");
+
+  // energies command
+  auto& energiesCmd
+    = fMessenger->DeclareMethod("energies",
+                                &EnergyScan::SetEnergies,
+                                "Scan the list of energies \"e1 e2 ... unit\";\n"
+                                "each energy is one slice.");
+  energiesCmd.SetParameterName("energies", false);
+  energiesCmd.SetToBeBroadcasted(false);
+
+  // logBins command
+  auto& logBinsCmd
+    = fMessenger->DeclareMethod("logBins",
+                                &EnergyScan::SetLogBins,
+                                "Scan \"n emin emax unit\": n log spaced energy "
+                                "slices,\nwith energies log uniform in each slice.");
+  logBinsCmd.SetParameterName("bins", false);
+  logBinsCmd.SetToBeBroadcasted(false);
+
+  // sampling command
+  auto& samplingCmd
+    = fMessenger->DeclareMethod("sampling",
+                                &EnergyScan::SetSampling,
+                                "Select the slice of each primary:\n"
+                                " roundRobin - primary index modulo the "
+                                "number of slices\n"
+                                " random     - at random");
+  samplingCmd.SetParameterName("sampling", false);
+  samplingCmd.SetCandidates("roundRobin random");
+  samplingCmd.SetToBeBroadcasted(false);
+
+  // clear command
+  auto& clearCmd
+    = fMessenger->DeclareMethod("clear",
+                                &EnergyScan::Clear,
+                                "Remove the energy scan.");
+  clearCmd.SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,204 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/EnergySpectrum.cc
+/// \brief Implementation of the B4::EnergySpectrum class
+
+#include "EnergySpectrum.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool EnergySpectrum::Load(const G4String& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if ( ! file ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open spectrum file " << fileName << "." << G4endl;
+    msg << "The spectrum was not changed.";
+    G4Exception("EnergySpectrum::Load()",
+      "MyCode0012", JustWarning, msg);
+    return false;
+  }
+
+  std::vector<G4double> low, high, weights;
+
+  char magic[8] = {};
+  file.read(magic, sizeof(magic));
+  if ( file && std::memcmp(magic, "B4SPEC01", sizeof(magic)) == 0 ) {
+    // binary format
+    std::int32_t nbins = 0;
+    file.read(reinterpret_cast<char*>(&nbins), sizeof(nbins));
+    for ( std::int32_t i = 0; file && i < nbins; ++i ) {
+      G4double record[3];
+      if ( file.read(reinterpret_cast<char*>(record), sizeof(record)) ) {
+        low.push_back(record[0] * MeV);
+        high.push_back(record[1] * MeV);
+        weights.push_back(record[2]);
+      }
+    }
+    if ( ! file || static_cast<std::int32_t>(low.size()) != nbins ) {
+      low.clear();
+    }
+  }
+  else {
+    // text format
+    file.clear();
+    file.seekg(0);
+    std::string line;
+    while ( std::getline(file, line) ) {
+      auto first = line.find_first_not_of(" \t\r");
+      if ( first == std::string::npos || line[first] == '#' ) continue;
+
+      std::istringstream is(line);
+      G4double elo = 0., ehi = 0., weight = 0.;
+      if ( ! ( is >> elo >> ehi >> weight ) ) {
+        low.clear();
+        break;
+      }
+      low.push_back(elo * MeV);
+      high.push_back(ehi * MeV);
+      weights.push_back(weight);
+    }
+  }
+
+  return Set(std::move(low), std::move(high), weights, fileName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void EnergySpectrum::SetWatt(G4double a, G4double b, G4double emax, G4int nbins)
+{
+  std::vector<G4double> low, high, weights;
+  auto width = emax / nbins;
+  for ( G4int i = 0; i < nbins; ++i ) {
+    auto energy = (i + 0.5) * width;
+    low.push_back(i * width);
+    high.push_back((i + 1) * width);
+    weights.push_back(std::exp(-energy / a) * std::sinh(std::sqrt(b * energy)));
+  }
+
+  Set(std::move(low), std::move(high), weights, "Watt spectrum");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool EnergySpectrum::Set(std::vector<G4double>&& low,
+                           std::vector<G4double>&& high,
+                           const std::vector<G4double>& weights,
+                           const G4String& source)
+{
+  // Check the bins
+  G4double sum = 0.;
+  G4bool valid = ! low.empty();
+  for ( std::size_t i = 0; valid && i < low.size(); ++i ) {
+    valid = ( low[i] >= 0. && high[i] > low[i] && weights[i] >= 0. );
+    sum += weights[i];
+  }
+  if ( ! valid || sum <= 0. ) {
+    G4ExceptionDescription msg;
+    msg << "Invalid or empty spectrum in " << source << ":" << G4endl;
+    msg << "the bins must have 0 <= Elo < Ehi and weight >= 0, "
+        << "with a positive sum of weights." << G4endl;
+    msg << "The spectrum was not changed.";
+    G4Exception("EnergySpectrum::Set()",
+      "MyCode0012", JustWarning, msg);
+    return false;
+  }
+
+  auto nbins = low.size();
+  fLow = std::move(low);
+  fWidth.resize(nbins);
+  fMeanEnergy = 0.;
+  for ( std::size_t i = 0; i < nbins; ++i ) {
+    fWidth[i] = high[i] - fLow[i];
+    fMeanEnergy += weights[i] * (fLow[i] + 0.5 * fWidth[i]) / sum;
+  }
+
+  // Build the alias table (Vose's method)
+  fProbability.resize(nbins);
+  fAlias.resize(nbins);
+  std::vector<G4double> scaled(nbins);
+  std::vector<std::size_t> small, large;
+  for ( std::size_t i = 0; i < nbins; ++i ) {
+    scaled[i] = weights[i] * nbins / sum;
+    if ( scaled[i] < 1. ) small.push_back(i);
+    else                  large.push_back(i);
+  }
+  while ( ! small.empty() && ! large.empty() ) {
+    auto s = small.back();
+    small.pop_back();
+    auto l = large.back();
+    large.pop_back();
+
+    fProbability[s] = scaled[s];
+    fAlias[s] = l;
+    scaled[l] += scaled[s] - 1.;
+    if ( scaled[l] < 1. ) small.push_back(l);
+    else                  large.push_back(l);
+  }
+  // the remaining bins are full, up to rounding errors
+  for ( auto i : small ) {
+    fProbability[i] = 1.;
+    fAlias[i] = i;
+  }
+  for ( auto i : large ) {
+    fProbability[i] = 1.;
+    fAlias[i] = i;
+  }
+
+  G4cout
+    << "--> Energy spectrum from " << source << ": " << nbins << " bins, "
+    << "mean energy " << G4BestUnit(fMeanEnergy, "Energy") << G4endl;
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double EnergySpectrum::Sample() const
+{
+  auto u1 = G4UniformRand();
+  auto u2 = G4UniformRand();
+  return Sample(u1, u2);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
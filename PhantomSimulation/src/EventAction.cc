@@ -29,9 +29,12 @@
 
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "PrimaryInfo.hh"
 
 #include "G4AnalysisManager.hh"
+#include "G4HCofThisEvent.hh"
 #include "G4RunManager.hh"
+#include "G4SDManager.hh"
 #include "G4Event.hh"
 #include "G4UnitsTable.hh"
 
@@ -43,43 +46,103 @@ namespace B4a
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EventAction::BeginOfEventAction(const G4Event* /*event*/)
+EventAction::EventAction(B4::RunAction* runAction)
+ : fRunAction(runAction)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+DetectorHitsCollection*
+EventAction::GetHitsCollection(G4int hcID,
+                               const G4Event* event) const
 {
-  // initialisation per event
-  fEnergyDetector = 0.;
-  fTrackLDetector = 0.;
+  auto hitsCollection
+    = static_cast<DetectorHitsCollection*>(
+        event->GetHCofThisEvent()->GetHC(hcID));
+
+  if ( ! hitsCollection ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot access hitsCollection ID " << hcID;
+    G4Exception("EventAction::GetHitsCollection()",
+      "MyCode0003", FatalException, msg);
+  }
+
+  return hitsCollection;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void EventAction::BeginOfEventAction(const G4Event* /*event*/)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void EventAction::EndOfEventAction(const G4Event* event)
 {
+    // Get hits collection ID (only once)
+    if ( fDetectorHCID == -1 ) {
+      fDetectorHCID
+        = G4SDManager::GetSDMpointer()->GetCollectionID("DetectorHitsCollection");
+    }
+
+    auto detectorHC = GetHitsCollection(fDetectorHCID, event);
+
     G4int nPrimaries = event->GetNumberOfPrimaryVertex();
+    fRunAction->AddPrimaries(nPrimaries);
 
     for (G4int iVertex = 0; iVertex < nPrimaries; ++iVertex) {
         G4PrimaryVertex* vertex = event->GetPrimaryVertex(iVertex);
         G4PrimaryParticle* primary = vertex->GetPrimary();
 
+        // Get the detector totals hit of this primary
+        if (iVertex >= static_cast<G4int>(detectorHC->entries())) break;
+        auto detectorHit = (*detectorHC)[iVertex];
+        auto energyDetector = detectorHit->GetEdep();
+        auto trackLDetector = detectorHit->GetTrackLength();
+
         if (primary->GetPDGcode() == 2112) {
             auto analysisManager = G4AnalysisManager::Instance();
 
-            // fill histograms
-            analysisManager->FillH1(0, fEnergyDetector); 
-            analysisManager->FillH1(1, fTrackLDetector);
-
-            // fill ntuple
-            analysisManager->FillNtupleDColumn(0, fEnergyDetector);
-            analysisManager->FillNtupleDColumn(1, fTrackLDetector);
-            analysisManager->AddNtupleRow();
+            // the hit values are weighted with the track weights:
+            // fill the values per unit primary weight, with this weight
+            auto weight = vertex->GetWeight();
+            fRunAction->AddDetectorTotals(energyDetector, trackLDetector, weight);
+
+            // with importance biasing, only the means are valid
+            // and the spectra are not booked
+            if (fRunAction->HasPulseHeightSpectra()) {
+                auto energyPerWeight = energyDetector / weight;
+                auto trackLPerWeight = trackLDetector / weight;
+
+                // the energy scan bin of the primary, or -1
+                auto info
+                  = dynamic_cast<B4::PrimaryInfo*>(primary->GetUserInformation());
+                auto energyBin = info ? info->GetEnergyBin() : -1;
+
+                // fill histograms
+                analysisManager->FillH1(0, energyPerWeight, weight);
+                analysisManager->FillH1(1, trackLPerWeight, weight);
+                fRunAction->FillSlice(energyBin, energyPerWeight,
+                                      trackLPerWeight, weight);
+
+                // fill ntuple
+                analysisManager->FillNtupleDColumn(0, energyPerWeight);
+                analysisManager->FillNtupleDColumn(1, trackLPerWeight);
+                analysisManager->FillNtupleDColumn(2, weight);
+                analysisManager->FillNtupleIColumn(3, energyBin);
+                analysisManager->AddNtupleRow();
+            }
 
             auto eventID = event->GetEventID();
             auto printModulo = G4RunManager::GetRunManager()->GetPrintProgress();
-            if ((printModulo > 0) && (eventID % printModulo == 0)) {
+            if ((printModulo > 0) && (eventID % printModulo == 0) &&
+                iVertex == 0) {
                 G4cout
                     << "   Detector: total energy: " << std::setw(7)
-                    << G4BestUnit(fEnergyDetector, "Energy")
+                    << G4BestUnit(energyDetector, "Energy")
                     << "       total track length: " << std::setw(7)
-                    << G4BestUnit(fTrackLDetector, "Length")
+                    << G4BestUnit(trackLDetector, "Length")
+                    << " (first of " << nPrimaries << " primaries)"
                     << G4endl;
 
                 G4cout << "--> End of event " << eventID << "\n" << G4endl;
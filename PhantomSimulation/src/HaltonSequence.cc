@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/HaltonSequence.cc
+/// \brief Implementation of the B4::HaltonSequence class
+
+#include "HaltonSequence.hh"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+  // SplitMix64: a small portable generator for the permutations
+  std::uint64_t NextRandom(std::uint64_t& state)
+  {
+    auto z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  // the largest double below 1
+  constexpr G4double kOneMinusEpsilon = 0x1.fffffffffffffp-1;
+}
+
+namespace B4
+{
+
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+HaltonSequence::HaltonSequence()
+{
+  Scramble(0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HaltonSequence::Scramble(std::uint64_t seed)
+{
+  auto state = seed;
+  for ( G4int dim = 0; dim < kMaxDims; ++dim ) {
+    auto& permutation = fPermutations[dim];
+    permutation.resize(kBases[dim]);
+    std::iota(permutation.begin(), permutation.end(), 0);
+
+    // Fisher-Yates shuffle
+    for ( auto i = kBases[dim] - 1; i > 0; --i ) {
+      auto j = static_cast<G4int>(NextRandom(state) % (i + 1));
+      std::swap(permutation[i], permutation[j]);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double HaltonSequence::Sample(std::uint64_t index, G4int dim) const
+{
+  const auto base = static_cast<std::uint64_t>(kBases[dim]);
+  const auto& permutation = fPermutations[dim];
+  const auto invBase = 1. / base;
+
+  // permuted digits of the index, mirrored around the radix point
+  std::uint64_t reversed = 0;
+  G4double invBaseN = 1.;
+  while ( index > 0 ) {
+    auto next = index / base;
+    auto digit = index - next * base;
+    reversed = reversed * base + permutation[digit];
+    invBaseN *= invBase;
+    index = next;
+  }
+
+  // the infinite tail of zero digits is permuted as well
+  auto value
+    = invBaseN * (reversed + invBase * permutation[0] / (1. - invBase));
+  return std::min(value, kOneMinusEpsilon);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
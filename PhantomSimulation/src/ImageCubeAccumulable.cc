@@ -0,0 +1,114 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/ImageCubeAccumulable.cc
+/// \brief Implementation of the B4::ImageCubeAccumulable class
+
+#include "ImageCubeAccumulable.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <cstdint>
+#include <fstream>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImageCubeAccumulable::ImageCubeAccumulable(const G4String& name)
+ : G4VAccumulable(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImageCubeAccumulable::Merge(const G4VAccumulable& other)
+{
+  fData.Add(static_cast<const ImageCubeAccumulable&>(other).fData);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImageCubeAccumulable::Reset()
+{
+  fData.Zero();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImageCubeAccumulable::SetLayout(G4int nbinsxy, G4double xymin, G4double xymax,
+                                     G4int nbinse, G4double emin, G4double emax)
+{
+  fNbinsXY = nbinsxy;
+  fNbinsE = nbinse;
+  fXYmin = xymin;
+  fXYmax = xymax;
+  fEmin = emin;
+  fEmax = emax;
+  fLogEmin = std::log(emin);
+  fInvWidthXY = nbinsxy / (xymax - xymin);
+  fInvLogWidthE = nbinse / (std::log(emax) - fLogEmin);
+
+  fData.Resize(static_cast<std::size_t>(nbinsxy) * nbinsxy * nbinse);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImageCubeAccumulable::Clear()
+{
+  fData.Resize(0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ImageCubeAccumulable::Write(const G4String& fileName) const
+{
+  std::ofstream file(fileName, std::ios::binary);
+  if ( ! file ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open file " << fileName << " for writing.";
+    G4Exception("ImageCubeAccumulable::Write()",
+      "MyCode0006", JustWarning, msg);
+    return false;
+  }
+
+  const char magic[8] = { 'B', '4', 'C', 'U', 'B', 'E', '0', '1' };
+  const std::int32_t nbins[3] = { fNbinsXY, fNbinsXY, fNbinsE };
+  const G4double limits[6]
+    = { fXYmin/mm, fXYmax/mm, fXYmin/mm, fXYmax/mm, fEmin/MeV, fEmax/MeV };
+
+  file.write(magic, sizeof(magic));
+  file.write(reinterpret_cast<const char*>(nbins), sizeof(nbins));
+  file.write(reinterpret_cast<const char*>(limits), sizeof(limits));
+  file.write(reinterpret_cast<const char*>(fData.Data()),
+             fData.Size() * sizeof(G4float));
+
+  return file.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,170 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/ImportanceWorldConstruction.cc
+/// \brief Implementation of the B4::ImportanceWorldConstruction class
+
+#include "ImportanceWorldConstruction.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Box.hh"
+#include "G4GenericMessenger.hh"
+#include "G4GeometryCell.hh"
+#include "G4IStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VSolid.hh"
+#include "G4ios.hh"
+
+#include <cmath>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceWorldConstruction::ImportanceWorldConstruction(
+  const G4String& worldName, const DetectorConstruction* massWorld)
+ : G4VUserParallelWorld(worldName),
+   fMassWorld(massWorld)
+{
+  // Define commands for this class
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceWorldConstruction::~ImportanceWorldConstruction()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorldConstruction::Construct()
+{
+  auto ghostWorld = GetWorld();
+  auto ghostWorldLV = ghostWorld->GetLogicalVolume();
+  G4ThreeVector worldMin, worldMax;
+  ghostWorldLV->GetSolid()->BoundingLimits(worldMin, worldMax);
+
+  // Lead plate extent along z
+  auto leadPV = fMassWorld->GetphysPlomo();
+  G4ThreeVector leadMin, leadMax;
+  leadPV->GetLogicalVolume()->GetSolid()->BoundingLimits(leadMin, leadMax);
+  auto leadFrontZ = leadPV->GetTranslation().z() + leadMin.z();
+  auto leadBackZ = leadPV->GetTranslation().z() + leadMax.z();
+
+  // Slab edges along z
+  std::vector<G4double> edges { worldMin.z(), leadFrontZ };
+  for ( G4int i = 1; i <= fNofLeadSlices; ++i ) {
+    edges.push_back(leadFrontZ + i * (leadBackZ - leadFrontZ) / fNofLeadSlices);
+  }
+  edges.push_back(worldMax.z());
+
+  // the parallel world itself is a cell too
+  fCells.clear();
+  fCells.emplace_back(ghostWorld, 1.);
+
+  G4cout << G4endl << " Importance cells:" << G4endl;
+  for ( std::size_t k = 0; k + 1 < edges.size(); ++k ) {
+    auto halfZ = 0.5 * (edges[k+1] - edges[k]);
+    auto centerZ = 0.5 * (edges[k+1] + edges[k]);
+    auto cellBox = new G4Box("ImportanceCell",
+                             worldMax.x(), worldMax.y(), halfZ);
+    auto cellLV = new G4LogicalVolume(cellBox, nullptr, "ImportanceCell");
+    auto cellPV = new G4PVPlacement(nullptr,                       // no rotation
+                                    G4ThreeVector(0., 0., centerZ),
+                                    cellLV,                        // its logical volume
+                                    "ImportanceCell",              // its name
+                                    ghostWorldLV,                  // its mother volume
+                                    false,                         // no boolean operation
+                                    static_cast<G4int>(k));        // copy number
+
+    auto importance
+      = ( k == 0 ) ? 1. : std::pow(fImportanceRatio, static_cast<G4double>(k - 1));
+    fCells.emplace_back(cellPV, importance);
+
+    G4cout
+      << "   cell " << k << ": z in [" << edges[k] / cm << ", "
+      << edges[k+1] / cm << "] cm, importance " << importance << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorldConstruction::ConstructSD()
+{
+  // Fill the importance store of this thread
+  auto istore = G4IStore::GetInstance(GetName());
+  for ( const auto& [cellPV, importance] : fCells ) {
+    G4GeometryCell cell(*cellPV, cellPV->GetCopyNo());
+    if ( istore->IsKnown(cell) ) {
+      istore->ChangeImportance(importance, cell);
+    }
+    else {
+      istore->AddImportanceGeometryCell(importance, cell);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorldConstruction::DefineCommands()
+{
+  // Define /phantom/biasing command directory using generic messenger class
+  fMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/biasing/",
+                             "Geometry importance biasing control");
+
+  // nofLeadSlices command
+  auto& slicesCmd
+    = fMessenger->DeclareProperty("nofLeadSlices",
+                                  fNofLeadSlices,
+                                  "Set the number of importance cells "
+                                  "in the lead plate.");
+  slicesCmd.SetParameterName("n", false);
+  slicesCmd.SetRange("n>=1");
+  slicesCmd.AvailableForStates(G4State_PreInit);
+  slicesCmd.SetToBeBroadcasted(false);
+
+  // importanceRatio command
+  auto& ratioCmd
+    = fMessenger->DeclareProperty("importanceRatio",
+                                  fImportanceRatio,
+                                  "Set the importance ratio of consecutive "
+                                  "cells through the lead plate.");
+  ratioCmd.SetParameterName("ratio", false);
+  ratioCmd.SetRange("ratio>=1.");
+  ratioCmd.AvailableForStates(G4State_PreInit);
+  ratioCmd.SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,118 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/KillZoneSD.cc
+/// \brief Implementation of the B4a::KillZoneSD class
+
+#include "KillZoneSD.hh"
+#include "TallyAccumulable.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4Neutron.hh"
+#include "G4Step.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <algorithm>
+#include <utility>
+
+namespace B4a
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+KillZoneSD::KillZoneSD(const G4String& name)
+ : G4VSensitiveDetector(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void KillZoneSD::Initialize(G4HCofThisEvent*)
+{
+  // Get the thread local kill zones tally (only once)
+  if ( ! fTally ) {
+    fTally = static_cast<B4::TallyAccumulable*>(
+      G4AccumulableManager::Instance()->GetAccumulable("KillZones"));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool KillZoneSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  auto track = step->GetTrack();
+  if ( track->GetDefinition() != G4Neutron::Definition() ) return false;
+
+  auto preStepPoint = step->GetPreStepPoint();
+  if ( CanReachTarget(preStepPoint->GetPosition(),
+                      preStepPoint->GetMomentumDirection()) ) return false;
+
+  track->SetTrackStatus(fStopAndKill);
+  if ( fTally ) {
+    fTally->Add(preStepPoint->GetPhysicalVolume()->GetName(),
+                preStepPoint->GetWeight());
+  }
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void KillZoneSD::SetTargetBox(const G4ThreeVector& pMin,
+                              const G4ThreeVector& pMax)
+{
+  fTargetMin = pMin;
+  fTargetMax = pMax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool KillZoneSD::CanReachTarget(const G4ThreeVector& position,
+                                  const G4ThreeVector& direction) const
+{
+  // Ray - box intersection (slab method), forward direction only
+  G4double tMin = 0.;
+  G4double tMax = DBL_MAX;
+  for ( G4int i = 0; i < 3; ++i ) {
+    if ( direction[i] == 0. ) {
+      if ( position[i] < fTargetMin[i] || position[i] > fTargetMax[i] ) {
+        return false;
+      }
+      continue;
+    }
+    auto t1 = (fTargetMin[i] - position[i]) / direction[i];
+    auto t2 = (fTargetMax[i] - position[i]) / direction[i];
+    if ( t1 > t2 ) std::swap(t1, t2);
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+    if ( tMin > tMax ) return false;
+  }
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
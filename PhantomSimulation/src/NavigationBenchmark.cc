@@ -0,0 +1,199 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/NavigationBenchmark.cc
+/// \brief Implementation of the B4::NavigationBenchmark class
+
+#include "NavigationBenchmark.hh"
+#include "HaltonSequence.hh"
+
+#include "G4GeometryManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  // elapsed time in ns
+  G4double ElapsedTime(Clock::time_point start, Clock::time_point end)
+  {
+    return std::chrono::duration<G4double, std::nano>(end - start).count();
+  }
+
+  // calls and total times of the navigation methods in one volume
+  struct VolumeTimes {
+    G4long fNofSteps = 0;
+    G4double fStepTime = 0.;
+    G4long fNofLocates = 0;
+    G4double fLocateTime = 0.;
+  };
+}
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NavigationBenchmark::NavigationBenchmark(G4double beamHalfSize,
+                                         G4double coneHalfAngle)
+ : fBeamHalfSize(beamHalfSize),
+   fConeHalfAngle(coneHalfAngle)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NavigationBenchmark::Run(G4VPhysicalVolume* world, G4int nofRays) const
+{
+  // Rebuild the smart voxels with the current settings
+  auto geometryManager = G4GeometryManager::GetInstance();
+  geometryManager->OpenGeometry();
+  auto voxelStart = Clock::now();
+  geometryManager->CloseGeometry(true);
+  auto voxelTime = ElapsedTime(voxelStart, Clock::now());
+
+  // Clock overhead, included in each measured time
+  const G4int nofClockCalls = 100000;
+  auto clockStart = Clock::now();
+  for ( G4int i = 0; i < nofClockCalls; ++i ) Clock::now();
+  auto clockOverhead = ElapsedTime(clockStart, Clock::now()) / nofClockCalls;
+
+  G4ThreeVector worldMin, worldMax;
+  world->GetLogicalVolume()->GetSolid()->BoundingLimits(worldMin, worldMax);
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  HaltonSequence halton;
+  std::map<const G4LogicalVolume*, VolumeTimes> times;
+  const auto cosMin = std::cos(fConeHalfAngle);
+  G4long nofSteps = 0;
+
+  for ( G4int i = 0; i < nofRays; ++i ) {
+    G4ThreeVector point((2. * halton.Sample(i, 0) - 1.) * fBeamHalfSize,
+                        (2. * halton.Sample(i, 1) - 1.) * fBeamHalfSize,
+                        worldMin.z() + 1. * um);
+    auto cosTheta = 1. - halton.Sample(i, 2) * (1. - cosMin);
+    auto sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+    auto phi = twopi * halton.Sample(i, 3);
+    G4ThreeVector direction(sinTheta * std::cos(phi),
+                            sinTheta * std::sin(phi), cosTheta);
+
+    auto start = Clock::now();
+    auto volume = navigator.LocateGlobalPointAndSetup(point, &direction,
+                                                      false, false);
+    auto& startTimes = times[volume ? volume->GetLogicalVolume()
+                                    : world->GetLogicalVolume()];
+    startTimes.fNofLocates += 1;
+    startTimes.fLocateTime += ElapsedTime(start, Clock::now());
+
+    for ( G4int k = 0; volume && k < kMaxStepsPerRay; ++k ) {
+      G4double safety = 0.;
+      start = Clock::now();
+      auto step = navigator.ComputeStep(point, direction, kInfinity, safety);
+      auto& stepTimes = times[volume->GetLogicalVolume()];
+      stepTimes.fNofSteps += 1;
+      stepTimes.fStepTime += ElapsedTime(start, Clock::now());
+      ++nofSteps;
+      if ( step == kInfinity ) break;
+
+      point += step * direction;
+      navigator.SetGeometricallyLimitedStep();
+      start = Clock::now();
+      volume = navigator.LocateGlobalPointAndSetup(point, &direction,
+                                                   true, false);
+      auto& locateTimes = times[volume ? volume->GetLogicalVolume()
+                                       : world->GetLogicalVolume()];
+      locateTimes.fNofLocates += 1;
+      locateTimes.fLocateTime += ElapsedTime(start, Clock::now());
+    }
+  }
+
+  // Print the volumes sorted by total time
+  std::vector<std::pair<const G4LogicalVolume*, VolumeTimes>> sorted(
+    times.begin(), times.end());
+  std::sort(sorted.begin(), sorted.end(),
+    [](const auto& a, const auto& b) {
+      return a.second.fStepTime + a.second.fLocateTime
+             > b.second.fStepTime + b.second.fLocateTime; });
+
+  G4double totalTime = 0.;
+  for ( const auto& entry : sorted ) {
+    totalTime += entry.second.fStepTime + entry.second.fLocateTime;
+  }
+
+  G4cout
+    << G4endl
+    << " Navigation benchmark: " << nofRays << " rays, " << nofSteps
+    << " steps, " << totalTime / 1.e6 << " ms (voxels built in "
+    << voxelTime / 1.e6 << " ms, clock overhead "
+    << clockOverhead << " ns per call)" << G4endl
+    << "   " << std::setw(24) << std::left << "volume" << std::right
+    << std::setw(10) << "daughters" << std::setw(10) << "smartless"
+    << std::setw(9) << "optimise"
+    << std::setw(12) << "steps" << std::setw(10) << "ns/step"
+    << std::setw(12) << "locates" << std::setw(12) << "ns/locate"
+    << std::setw(8) << "time %" << G4endl;
+
+  for ( const auto& [logicalVolume, volumeTimes] : sorted ) {
+    auto stepMean = volumeTimes.fNofSteps > 0
+      ? volumeTimes.fStepTime / volumeTimes.fNofSteps : 0.;
+    auto locateMean = volumeTimes.fNofLocates > 0
+      ? volumeTimes.fLocateTime / volumeTimes.fNofLocates : 0.;
+    auto share = totalTime > 0.
+      ? 100. * (volumeTimes.fStepTime + volumeTimes.fLocateTime) / totalTime
+      : 0.;
+    G4cout
+      << "   " << std::setw(24) << std::left << logicalVolume->GetName()
+      << std::right
+      << std::setw(10) << logicalVolume->GetNoDaughters()
+      << std::setw(10) << logicalVolume->GetSmartless()
+      << std::setw(9) << ( logicalVolume->IsToOptimise() ? "yes" : "no" )
+      << std::setw(12) << volumeTimes.fNofSteps
+      << std::setw(10) << std::fixed << std::setprecision(1) << stepMean
+      << std::setw(12) << volumeTimes.fNofLocates
+      << std::setw(12) << locateMean
+      << std::setw(8) << share << std::defaultfloat << std::setprecision(6)
+      << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
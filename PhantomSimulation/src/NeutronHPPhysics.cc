@@ -0,0 +1,98 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/NeutronHPPhysics.cc
+/// \brief Implementation of the B4::NeutronHPPhysics class
+
+#include "NeutronHPPhysics.hh"
+
+#include "G4HadronElasticProcess.hh"
+#include "G4HadronInelasticProcess.hh"
+#include "G4Neutron.hh"
+#include "G4NeutronCaptureProcess.hh"
+#include "G4ParticleHPCapture.hh"
+#include "G4ParticleHPCaptureData.hh"
+#include "G4ParticleHPElastic.hh"
+#include "G4ParticleHPElasticData.hh"
+#include "G4ParticleHPInelastic.hh"
+#include "G4ParticleHPInelasticData.hh"
+#include "G4ParticleHPThermalScattering.hh"
+#include "G4ParticleHPThermalScatteringData.hh"
+#include "G4ProcessManager.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NeutronHPPhysics::NeutronHPPhysics(const G4String& name)
+ : G4VPhysicsConstructor(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronHPPhysics::ConstructParticle()
+{
+  G4Neutron::Definition();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronHPPhysics::ConstructProcess()
+{
+  auto processManager = G4Neutron::Definition()->GetProcessManager();
+
+  // elastic scattering: free gas model above 4 eV, thermal scattering
+  // (bound atoms, S(alpha,beta) data) below, as in G4ThermalNeutrons
+  auto elastic = new G4HadronElasticProcess();
+  elastic->AddDataSet(new G4ParticleHPElasticData());
+  auto elasticModel = new G4ParticleHPElastic();
+  elasticModel->SetMinEnergy(4.*eV);
+  elastic->RegisterMe(elasticModel);
+  elastic->AddDataSet(new G4ParticleHPThermalScatteringData());
+  auto thermalModel = new G4ParticleHPThermalScattering();
+  thermalModel->SetMaxEnergy(4.*eV);
+  elastic->RegisterMe(thermalModel);
+  processManager->AddDiscreteProcess(elastic);
+
+  // inelastic reactions
+  auto inelastic
+    = new G4HadronInelasticProcess("neutronInelastic", G4Neutron::Definition());
+  inelastic->AddDataSet(new G4ParticleHPInelasticData());
+  inelastic->RegisterMe(new G4ParticleHPInelastic());
+  processManager->AddDiscreteProcess(inelastic);
+
+  // radiative capture
+  auto capture = new G4NeutronCaptureProcess();
+  capture->AddDataSet(new G4ParticleHPCaptureData());
+  capture->RegisterMe(new G4ParticleHPCapture());
+  processManager->AddDiscreteProcess(capture);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,210 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/OverlapCache.cc
+/// \brief Implementation of the B4::OverlapCache class
+
+#include "OverlapCache.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4Timer.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Version.hh"
+#include "G4ios.hh"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <streambuf>
+
+namespace B4
+{
+
+namespace
+{
+
+// Stream buffer which hashes the characters written to it (FNV-1a)
+class HashBuffer : public std::streambuf
+{
+  public:
+    std::uint64_t GetHash() const { return fHash; }
+
+  protected:
+    int_type overflow(int_type c) override
+    {
+      if ( c != traits_type::eof() ) Add(static_cast<char>(c));
+      return c;
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+      for ( std::streamsize i = 0; i < n; ++i ) Add(s[i]);
+      return n;
+    }
+
+  private:
+    void Add(char c)
+    {
+      fHash ^= static_cast<unsigned char>(c);
+      fHash *= 0x100000001b3ULL;
+    }
+
+    std::uint64_t fHash = 0xcbf29ce484222325ULL;
+};
+
+void Describe(std::ostream& os, const G4VPhysicalVolume* volume)
+{
+  auto logicalVolume = volume->GetLogicalVolume();
+  os << volume->GetName() << ' ' << volume->GetCopyNo() << ' '
+     << volume->GetMultiplicity() << ' ' << volume->IsParameterised() << ' '
+     << volume->GetTranslation() << ' ';
+  if ( auto rotation = volume->GetRotation() ) os << *rotation;
+  os << logicalVolume->GetName() << ' '
+     << logicalVolume->GetMaterial()->GetName() << '\n';
+  logicalVolume->GetSolid()->StreamInfo(os);
+
+  for ( std::size_t i = 0; i < logicalVolume->GetNoDaughters(); ++i ) {
+    Describe(os, logicalVolume->GetDaughter(i));
+  }
+  os << "end " << volume->GetName() << '\n';
+}
+
+G4int CheckDaughters(const G4LogicalVolume* logicalVolume)
+{
+  G4int nofOverlaps = 0;
+  for ( std::size_t i = 0; i < logicalVolume->GetNoDaughters(); ++i ) {
+    auto daughter = logicalVolume->GetDaughter(i);
+    // the parameterised voxels fill their container by construction
+    if ( daughter->IsParameterised() || daughter->IsReplicated() ) continue;
+
+    if ( daughter->CheckOverlaps() ) ++nofOverlaps;
+    nofOverlaps += CheckDaughters(daughter->GetLogicalVolume());
+  }
+  return nofOverlaps;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int OverlapCache::Validate(const G4VPhysicalVolume* world)
+{
+  auto hash = ComputeHash(world);
+
+  G4int nofOverlaps = 0;
+  if ( Find(hash, nofOverlaps) ) {
+    G4cout
+      << "--> Overlap check skipped, geometry " << std::hex << hash
+      << std::dec << " validated before (" << fFileName << "): "
+      << nofOverlaps << " volume(s) with overlaps" << G4endl;
+  }
+  else {
+    G4Timer timer;
+    timer.Start();
+    nofOverlaps = CheckOverlaps(world);
+    timer.Stop();
+    Store(hash, nofOverlaps);
+
+    G4cout
+      << "--> Overlap check of geometry " << std::hex << hash << std::dec
+      << " in " << timer.GetRealElapsed() << " s: "
+      << nofOverlaps << " volume(s) with overlaps" << G4endl;
+  }
+
+  if ( nofOverlaps > 0 ) {
+    G4ExceptionDescription msg;
+    msg << nofOverlaps << " volume(s) overlap other volumes.";
+    G4Exception("OverlapCache::Validate()",
+      "MyCode0018", JustWarning, msg);
+  }
+
+  return nofOverlaps;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int OverlapCache::CheckOverlaps(const G4VPhysicalVolume* world)
+{
+  return CheckDaughters(world->GetLogicalVolume());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::uint64_t OverlapCache::ComputeHash(const G4VPhysicalVolume* world)
+{
+  HashBuffer buffer;
+  std::ostream os(&buffer);
+  os << std::setprecision(17);
+  os << "Geant4 " << G4VERSION_NUMBER << '\n';
+  Describe(os, world);
+  os.flush();
+
+  return buffer.GetHash();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool OverlapCache::Find(std::uint64_t hash, G4int& nofOverlaps) const
+{
+  std::ifstream file(fFileName);
+  std::string line;
+  while ( std::getline(file, line) ) {
+    std::istringstream is(line);
+    std::uint64_t cachedHash = 0;
+    G4int cachedNofOverlaps = 0;
+    if ( is >> std::hex >> cachedHash >> std::dec >> cachedNofOverlaps &&
+         cachedHash == hash ) {
+      nofOverlaps = cachedNofOverlaps;
+      return true;
+    }
+  }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void OverlapCache::Store(std::uint64_t hash, G4int nofOverlaps) const
+{
+  // one short line appended at once, so that concurrent jobs do not
+  // interleave their results
+  std::ostringstream line;
+  line << std::hex << hash << std::dec << ' ' << nofOverlaps << '\n';
+
+  std::ofstream file(fFileName, std::ios::app);
+  file << line.str() << std::flush;
+  if ( ! file ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot write the overlap cache file " << fFileName << ".";
+    G4Exception("OverlapCache::Store()",
+      "MyCode0018", JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
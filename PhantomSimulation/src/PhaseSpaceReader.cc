@@ -0,0 +1,176 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/PhaseSpaceReader.cc
+/// \brief Implementation of the B4::PhaseSpaceReader class
+
+#include "PhaseSpaceReader.hh"
+
+#include "G4ios.hh"
+
+#include <cstring>
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  define NOMINMAX
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceReader::~PhaseSpaceReader()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhaseSpaceReader::Open(const G4String& fileName)
+{
+  Close();
+
+  G4String error;
+#ifdef _WIN32
+  auto file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                          nullptr, OPEN_EXISTING,
+                          FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  LARGE_INTEGER size;
+  if ( file == INVALID_HANDLE_VALUE ) {
+    error = "cannot open the file";
+  }
+  else if ( ! GetFileSizeEx(file, &size) || size.QuadPart == 0 ) {
+    CloseHandle(file);
+    error = "cannot get the file size";
+  }
+  else {
+    auto mappingHandle
+      = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    auto mapping = mappingHandle
+      ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if ( ! mapping ) {
+      if ( mappingHandle ) CloseHandle(mappingHandle);
+      CloseHandle(file);
+      error = "cannot map the file";
+    }
+    else {
+      fFileHandle = file;
+      fMappingHandle = mappingHandle;
+      fMapping = mapping;
+      fMappingSize = static_cast<std::size_t>(size.QuadPart);
+    }
+  }
+#else
+  auto file = open(fileName.c_str(), O_RDONLY);
+  struct stat status;
+  if ( file < 0 ) {
+    error = "cannot open the file";
+  }
+  else if ( fstat(file, &status) != 0 || status.st_size == 0 ) {
+    close(file);
+    error = "cannot get the file size";
+  }
+  else {
+    auto size = static_cast<std::size_t>(status.st_size);
+    auto mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    // the mapping stays valid after the file is closed
+    close(file);
+    if ( mapping == MAP_FAILED ) {
+      error = "cannot map the file";
+    }
+    else {
+      madvise(mapping, size, MADV_SEQUENTIAL);
+      fMapping = mapping;
+      fMappingSize = size;
+    }
+  }
+#endif
+
+  // Check the header
+  if ( error.empty() ) {
+    auto data = static_cast<const char*>(fMapping);
+    std::uint64_t nofRecords = 0;
+    if ( fMappingSize < kPhaseSpaceHeaderSize ||
+         std::memcmp(data, kPhaseSpaceMagic, sizeof(kPhaseSpaceMagic)) != 0 ) {
+      error = "this is not a phase space file";
+    }
+    else {
+      std::memcpy(&nofRecords, data + sizeof(kPhaseSpaceMagic),
+                  sizeof(nofRecords));
+      if ( nofRecords == 0 ||
+           ( fMappingSize - kPhaseSpaceHeaderSize ) / sizeof(PhaseSpaceRecord)
+             < nofRecords ) {
+        error = "the file is empty or truncated";
+      }
+      else {
+        fRecords = reinterpret_cast<const PhaseSpaceRecord*>(
+                     data + kPhaseSpaceHeaderSize);
+        fNofRecords = static_cast<std::size_t>(nofRecords);
+      }
+    }
+  }
+
+  if ( ! error.empty() ) {
+    Close();
+    G4ExceptionDescription msg;
+    msg << "Cannot read phase space file " << fileName << ": " << error << ".";
+    G4Exception("PhaseSpaceReader::Open()",
+      "MyCode0013", JustWarning, msg);
+    return false;
+  }
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceReader::Close()
+{
+#ifdef _WIN32
+  if ( fMapping ) UnmapViewOfFile(fMapping);
+  if ( fMappingHandle ) CloseHandle(fMappingHandle);
+  if ( fFileHandle ) CloseHandle(fFileHandle);
+  fMappingHandle = nullptr;
+  fFileHandle = nullptr;
+#else
+  if ( fMapping ) munmap(fMapping, fMappingSize);
+#endif
+  fMapping = nullptr;
+  fMappingSize = 0;
+  fRecords = nullptr;
+  fNofRecords = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
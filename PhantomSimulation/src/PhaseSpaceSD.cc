@@ -0,0 +1,79 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/PhaseSpaceSD.cc
+/// \brief Implementation of the B4a::PhaseSpaceSD class
+
+#include "PhaseSpaceSD.hh"
+#include "PhaseSpaceWriter.hh"
+
+#include "G4Neutron.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace B4a
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceSD::PhaseSpaceSD(const G4String& name)
+ : G4VSensitiveDetector(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhaseSpaceSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  auto track = step->GetTrack();
+  if ( track->GetDefinition() != G4Neutron::Definition() ) return false;
+
+  // neutrons entering the plane, forward only
+  auto preStepPoint = step->GetPreStepPoint();
+  if ( preStepPoint->GetStepStatus() != fGeomBoundary ) return false;
+  const auto& direction = preStepPoint->GetMomentumDirection();
+  if ( direction.z() <= 0. ) return false;
+
+  auto writer = B4::PhaseSpaceWriter::Instance();
+  if ( ! writer->IsOpen() ) return false;
+
+  const auto& position = preStepPoint->GetPosition();
+  writer->Add({ static_cast<float>(position.x() / mm),
+                static_cast<float>(position.y() / mm),
+                static_cast<float>(position.z() / mm),
+                static_cast<float>(direction.x()),
+                static_cast<float>(direction.y()),
+                static_cast<float>(direction.z()),
+                static_cast<float>(preStepPoint->GetKineticEnergy() / MeV),
+                static_cast<float>(preStepPoint->GetWeight()) });
+
+  if ( writer->GetKillRecorded() ) track->SetTrackStatus(fStopAndKill);
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,127 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/PhaseSpaceWriter.cc
+/// \brief Implementation of the B4::PhaseSpaceWriter class
+
+#include "PhaseSpaceWriter.hh"
+
+#include "G4AutoLock.hh"
+#include "G4ios.hh"
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceWriter* PhaseSpaceWriter::Instance()
+{
+  static PhaseSpaceWriter instance;
+  return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhaseSpaceWriter::Open(const G4String& fileName)
+{
+  G4AutoLock lock(&fMutex);
+
+  if ( fIsOpen ) fFile.close();
+
+  fFile.open(fileName, std::ios::binary | std::ios::trunc);
+  fIsOpen = fFile.is_open();
+  if ( ! fIsOpen ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open phase space file " << fileName << " for writing.";
+    G4Exception("PhaseSpaceWriter::Open()",
+      "MyCode0013", JustWarning, msg);
+    return false;
+  }
+
+  // the number of records is updated in Close()
+  fNofRecords = 0;
+  fFile.write(kPhaseSpaceMagic, sizeof(kPhaseSpaceMagic));
+  fFile.write(reinterpret_cast<const char*>(&fNofRecords), sizeof(fNofRecords));
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceWriter::Close()
+{
+  G4AutoLock lock(&fMutex);
+
+  if ( ! fIsOpen ) return;
+
+  fFile.seekp(sizeof(kPhaseSpaceMagic));
+  fFile.write(reinterpret_cast<const char*>(&fNofRecords), sizeof(fNofRecords));
+  fFile.close();
+  fIsOpen = false;
+
+  G4cout << " Phase space: " << fNofRecords << " records written" << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<PhaseSpaceRecord>& PhaseSpaceWriter::GetBuffer()
+{
+  static G4ThreadLocal std::vector<PhaseSpaceRecord>* buffer = nullptr;
+  if ( ! buffer ) {
+    buffer = new std::vector<PhaseSpaceRecord>();
+    buffer->reserve(kBufferSize);
+  }
+  return *buffer;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceWriter::Add(const PhaseSpaceRecord& record)
+{
+  auto& buffer = GetBuffer();
+  buffer.push_back(record);
+  if ( buffer.size() >= kBufferSize ) Flush();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceWriter::Flush()
+{
+  auto& buffer = GetBuffer();
+  if ( buffer.empty() ) return;
+
+  G4AutoLock lock(&fMutex);
+  if ( fIsOpen ) {
+    fFile.write(reinterpret_cast<const char*>(buffer.data()),
+                buffer.size() * sizeof(PhaseSpaceRecord));
+    fNofRecords += buffer.size();
+  }
+  buffer.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,332 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/PhysicsTableCache.cc
+/// \brief Implementation of the B4::PhysicsTableCache class
+
+#include "PhysicsTableCache.hh"
+#include "StartupMonitor.hh"
+
+#include "G4Element.hh"
+#include "G4EmParameters.hh"
+#include "G4GenericMessenger.hh"
+#include "G4IonisParamMat.hh"
+#include "G4Material.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4RunManagerKernel.hh"
+#include "G4VUserPhysicsList.hh"
+#include "G4Version.hh"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsTableCache* PhysicsTableCache::Instance()
+{
+  // registered to the state manager of the master, which deletes it
+  static auto instance = new PhysicsTableCache();
+  return instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsTableCache::PhysicsTableCache()
+{
+  // Define commands for this class
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhysicsTableCache::~PhysicsTableCache()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhysicsTableCache::Notify(G4ApplicationState requestedState)
+{
+  // the state manager has already set the requested state as the current
+  // one, so the previous state is kept here
+  if ( fState == G4State_Idle && requestedState == G4State_Init ) {
+    // the run initialisation may go twice through Init when the geometry
+    // is rebuilt: the time is measured from the first one
+    if ( ! fInitialising ) {
+      fTimer.Start();
+      fInitialising = true;
+    }
+    SelectEntry();
+  }
+  fState = requestedState;
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::SelectEntry()
+{
+  auto physicsList = G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList();
+  if ( ! physicsList ) return;
+
+  // same physics list, materials and cuts as before: the tables are
+  // not rebuilt
+  auto key = fEnabled ? ComputeKey() : std::string("disabled");
+  if ( key == fKey ) return;
+  fKey = key;
+  fStorePending = false;
+
+  if ( ! fEnabled ) {
+    physicsList->ResetPhysicsTableRetrieved();
+    fStatus = Status::kDisabled;
+    return;
+  }
+
+  fEntryName = GetEntryName(key);
+  std::ifstream keyFile(fEntryName + "/key.txt");
+  std::string storedKey((std::istreambuf_iterator<char>(keyFile)),
+                         std::istreambuf_iterator<char>());
+  if ( keyFile.is_open() && storedKey == key ) {
+    physicsList->SetPhysicsTableRetrieved(fEntryName);
+    fStatus = Status::kRetrieved;
+  }
+  else {
+    physicsList->ResetPhysicsTableRetrieved();
+    fStorePending = true;
+    fStatus = Status::kBuilt;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::BeginOfRun()
+{
+  if ( fInitialising ) {
+    fTimer.Stop();
+    fInitialisationTime = fTimer.GetRealElapsed();
+    fInitialising = false;
+  }
+
+  if ( fStorePending ) {
+    Store();
+    fStorePending = false;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::Print()
+{
+  switch ( fStatus ) {
+    case Status::kNone:
+      return;
+    case Status::kDisabled:
+      G4cout << " Physics tables: built, cache disabled";
+      break;
+    case Status::kBuilt:
+      G4cout << " Physics tables: built, stored in " << fEntryName;
+      break;
+    case Status::kRetrieved:
+      G4cout << " Physics tables: retrieved from " << fEntryName;
+      break;
+  }
+  G4cout << " (run initialisation " << fInitialisationTime << " s)" << G4endl;
+
+  fStatus = Status::kNone;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::Clear()
+{
+  std::error_code error;
+  std::filesystem::remove_all(fDirectory.c_str(), error);
+  if ( error ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot remove the physics table cache " << fDirectory << ": "
+        << error.message();
+    G4Exception("PhysicsTableCache::Clear()",
+      "MyCode0021", JustWarning, msg);
+  }
+
+  // the tables are stored again at the next run
+  fKey.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::string PhysicsTableCache::ComputeKey()
+{
+  std::ostringstream os;
+  os << std::setprecision(17);
+  os << "Geant4 " << G4VERSION_NUMBER << '\n';
+  os << "physicsList " << StartupMonitor::Instance()->GetPhysicsListName() << '\n';
+
+  for ( auto material : *G4Material::GetMaterialTable() ) {
+    os << "material " << material->GetName() << ' '
+       << material->GetDensity() << ' ' << material->GetState() << ' '
+       << material->GetTemperature() << ' ' << material->GetPressure() << ' '
+       << material->GetIonisation()->GetMeanExcitationEnergy() << '\n';
+    auto fractions = material->GetFractionVector();
+    auto nofElements = static_cast<G4int>(material->GetNumberOfElements());
+    for ( G4int i = 0; i < nofElements; ++i ) {
+      auto element = material->GetElement(i);
+      os << "  " << element->GetName() << ' ' << element->GetZ() << ' '
+         << element->GetN() << ' ' << fractions[i] << '\n';
+    }
+  }
+
+  auto cutsTable = G4ProductionCutsTable::GetProductionCutsTable();
+  os << "cuts " << cutsTable->GetLowEdgeEnergy() << ' '
+     << cutsTable->GetHighEdgeEnergy() << '\n';
+  for ( auto region : *G4RegionStore::GetInstance() ) {
+    os << "region " << region->GetName();
+    if ( auto cuts = region->GetProductionCuts() ) {
+      for ( G4int i = 0; i < NumberOfG4CutIndex; ++i ) {
+        os << ' ' << cuts->GetProductionCut(i);
+      }
+    }
+    os << '\n';
+  }
+
+  G4EmParameters::Instance()->StreamInfo(os);
+
+  return os.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String PhysicsTableCache::GetEntryName(const std::string& key) const
+{
+  // 64 bits FNV-1a hash of the key text
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for ( auto c : key ) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ULL;
+  }
+
+  std::ostringstream name;
+  name << fDirectory << '/'
+       << StartupMonitor::Instance()->GetPhysicsListName() << '_'
+       << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return name.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::Store()
+{
+  namespace fs = std::filesystem;
+
+  auto physicsList = G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList();
+  if ( ! physicsList ) return;
+
+  // store in a directory of this job, with the key written last,
+  // then move it to the entry
+  fs::path entry(fEntryName.c_str());
+  auto temporary = entry;
+  temporary += ".tmp"
+    + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+  std::error_code error;
+  fs::create_directories(temporary, error);
+  auto stored = ! error && physicsList->StorePhysicsTable(temporary.string());
+  if ( stored ) {
+    std::ofstream keyFile(temporary / "key.txt");
+    keyFile << fKey << std::flush;
+    stored = keyFile.good();
+  }
+  if ( stored ) {
+    // replace an entry with a different key text
+    fs::remove_all(entry, error);
+    fs::rename(temporary, entry, error);
+    // another job may have stored the same entry meanwhile
+    stored = ! error || fs::exists(entry / "key.txt");
+  }
+  if ( ! stored ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot store the physics tables in " << fEntryName << ".";
+    G4Exception("PhysicsTableCache::Store()",
+      "MyCode0021", JustWarning, msg);
+  }
+  fs::remove_all(temporary, error);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsTableCache::DefineCommands()
+{
+  // Define /phantom/physicsCache command directory using generic messenger class
+  fMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/physicsCache/",
+                             "Physics table cache control");
+
+  // enable command
+  auto& enableCmd
+    = fMessenger->DeclareMethod("enable",
+                                &PhysicsTableCache::SetEnabled,
+                                "Retrieve the physics tables from the cache and "
+                                "store the new ones\n(true by default).");
+  enableCmd.SetParameterName("enable", true);
+  enableCmd.SetDefaultValue("true");
+  enableCmd.AvailableForStates(G4State_PreInit, G4State_Idle);
+  enableCmd.SetToBeBroadcasted(false);
+
+  // directory command
+  auto& directoryCmd
+    = fMessenger->DeclareMethod("directory",
+                                &PhysicsTableCache::SetDirectory,
+                                "Set the cache directory, with one entry per "
+                                "physics list, materials and cuts.");
+  directoryCmd.SetParameterName("directory", false);
+  directoryCmd.AvailableForStates(G4State_PreInit, G4State_Idle);
+  directoryCmd.SetToBeBroadcasted(false);
+
+  // clear command
+  auto& clearCmd
+    = fMessenger->DeclareMethod("clear",
+                                &PhysicsTableCache::Clear,
+                                "Remove the cache directory and all its entries.");
+  clearCmd.AvailableForStates(G4State_PreInit, G4State_Idle);
+  clearCmd.SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,145 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/PixelAccumulable.cc
+/// \brief Implementation of the B4::PixelAccumulable class
+
+#include "PixelAccumulable.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <cstdint>
+#include <fstream>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PixelAccumulable::PixelAccumulable(const G4String& name)
+ : G4VAccumulable(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PixelAccumulable::Merge(const G4VAccumulable& other)
+{
+  const auto& otherPixels = static_cast<const PixelAccumulable&>(other);
+  if ( ! otherPixels.IsActive() ) return;
+
+  // the master layout is only known from the workers
+  if ( ! IsActive() || fNx != otherPixels.fNx || fNy != otherPixels.fNy ||
+       fNbinsE != otherPixels.fNbinsE || fEmax != otherPixels.fEmax ) {
+    fNbinsE = otherPixels.fNbinsE;
+    fEmax = otherPixels.fEmax;
+    SetLayout(otherPixels.fNx, otherPixels.fNy,
+              otherPixels.fHalfX, otherPixels.fHalfY);
+  }
+
+  fCounts.Add(otherPixels.fCounts);
+  fEnergies.Add(otherPixels.fEnergies);
+  fSpectra.Add(otherPixels.fSpectra);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PixelAccumulable::Reset()
+{
+  fCounts.Zero();
+  fEnergies.Zero();
+  fSpectra.Zero();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PixelAccumulable::SetSpectrum(G4int nbinsE, G4double emax)
+{
+  fNbinsE = nbinsE;
+  fEmax = emax;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PixelAccumulable::SetLayout(G4int nx, G4int ny,
+                                 G4double halfX, G4double halfY)
+{
+  fNx = nx;
+  fNy = ny;
+  fHalfX = halfX;
+  fHalfY = halfY;
+  fInvWidthE = fNbinsE / fEmax;
+
+  auto nofPixels = static_cast<std::size_t>(nx) * ny;
+  fCounts.Resize(nofPixels);
+  fEnergies.Resize(nofPixels);
+  fSpectra.Resize(nofPixels * fNbinsE);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PixelAccumulable::Clear()
+{
+  fNx = 0;
+  fNy = 0;
+  fCounts.Resize(0);
+  fEnergies.Resize(0);
+  fSpectra.Resize(0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PixelAccumulable::Write(const G4String& fileName) const
+{
+  std::ofstream file(fileName, std::ios::binary);
+  if ( ! file ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open file " << fileName << " for writing.";
+    G4Exception("PixelAccumulable::Write()",
+      "MyCode0006", JustWarning, msg);
+    return false;
+  }
+
+  const char magic[8] = { 'B', '4', 'P', 'I', 'X', 'L', '0', '2' };
+  const std::int32_t nbins[3] = { fNx, fNy, fNbinsE };
+  const G4double limits[6]
+    = { -fHalfX/mm, fHalfX/mm, -fHalfY/mm, fHalfY/mm, 0., fEmax/MeV };
+
+  file.write(magic, sizeof(magic));
+  file.write(reinterpret_cast<const char*>(nbins), sizeof(nbins));
+  file.write(reinterpret_cast<const char*>(limits), sizeof(limits));
+  file.write(reinterpret_cast<const char*>(fCounts.Data()),
+             fCounts.Size() * sizeof(G4double));
+  file.write(reinterpret_cast<const char*>(fEnergies.Data()),
+             fEnergies.Size() * sizeof(G4double));
+  file.write(reinterpret_cast<const char*>(fSpectra.Data()),
+             fSpectra.Size() * sizeof(G4double));
+
+  return file.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -28,20 +28,52 @@
 /// \brief Implementation of the B4::PrimaryGeneratorAction class
 
 #include "PrimaryGeneratorAction.hh"
+#include "EnergyScan.hh"
+#include "PrimaryInfo.hh"
 
-#include "G4RunManager.hh"
-#include "G4LogicalVolumeStore.hh"
-#include "G4LogicalVolume.hh"
-#include "G4Box.hh"
-#include "G4Tubs.hh" //incluida por mi
 #include "G4Event.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4GenericMessenger.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
 #include "Randomize.hh"
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <sstream>
+
 
+namespace
+{
+  // Directions uniform in cones around the z axis, from two arrays of
+  // uniform random numbers: cos(theta) uniform in [cosHalfAngle[i], 1],
+  // phi uniform in [0, 360 deg].
+  // Plain loop over non-aliasing arrays: vectorised by the compiler
+  void SampleConeDirections(std::size_t n,
+                            const G4double* __restrict u,
+                            const G4double* __restrict v,
+                            const G4double* __restrict cosHalfAngle,
+                            G4double* __restrict dirX,
+                            G4double* __restrict dirY,
+                            G4double* __restrict dirZ)
+  {
+    for ( std::size_t i = 0; i < n; ++i ) {
+      auto cosTheta = cosHalfAngle[i] + (1. - cosHalfAngle[i]) * u[i];
+      auto sinTheta = std::sqrt((1. - cosTheta) * (1. + cosTheta));
+      auto phi = v[i] * CLHEP::twopi;
+      dirX[i] = sinTheta * std::cos(phi);
+      dirY[i] = sinTheta * std::sin(phi);
+      dirZ[i] = cosTheta;
+    }
+  }
+}
 
 namespace B4
 {
@@ -61,6 +93,11 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
   fParticleGun->SetParticlePosition(G4ThreeVector(0., 0., -40 * cm));
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
   fParticleGun->SetParticleEnergy(2.5*MeV);
+
+  fCosConeHalfAngle = std::cos(kConeHalfAngle);
+
+  // Define commands for this class
+  DefineCommands();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -68,6 +105,7 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
   delete fParticleGun;
+  delete fMessenger;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -76,58 +114,29 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
   // This function is called at the begining of event
 
-  // In order to avoid dependence of PrimaryGeneratorAction
-  // on DetectorConstruction class we get world volume
-  // from G4LogicalVolumeStore
-  //
-  G4double worldZHalfLength = 0.;
-  auto worldLV = G4LogicalVolumeStore::GetInstance()->GetVolume("World");
-
-    
-  // Check that the world volume has box shape
-  G4Box* worldBox = nullptr;
-  if (  worldLV ) {
-    worldBox = dynamic_cast<G4Box*>(worldLV->GetSolid());
-  }
-
-
-  if ( worldBox ) {
-    worldZHalfLength = worldBox->GetZHalfLength();
+  // Each run starts a new batch stream and a new sampling time
+  auto runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+  if ( runID != fRunID ) {
+    StartRun(runID);
   }
-  else  {
-    G4ExceptionDescription msg;
-    msg << "World volume of box shape not found." << G4endl;
-    msg << "Perhaps you have changed geometry." << G4endl;
-    msg << "The gun will be place in the center.";
-    G4Exception("PrimaryGeneratorAction::GeneratePrimaries()",
-      "MyCode0002", JustWarning, msg);
+  auto start = std::chrono::steady_clock::now();
+
+  // Each event has several independent primaries, one per vertex;
+  // the primary index numbers the primaries over the run
+  for ( G4int k = 0; k < fNofPrimaries; ++k ) {
+    auto primaryIndex
+      = static_cast<G4long>(anEvent->GetEventID()) * fNofPrimaries + k;
+    // Replay the phase space file, if selected
+    if ( fUsePhaseSpace && fPhaseSpace.GetNofRecords() > 0 ) {
+      GeneratePhaseSpacePrimary(anEvent, primaryIndex);
+    }
+    else {
+      GenerateGunPrimary(anEvent, primaryIndex);
+    }
   }
 
-
-  //Generacion de numero random entre 0.997199 y 1:
- // Definir los lmites del rango del coseno del ngulo
-  G4double cosMin = std::cos(8.0 * deg); // cos(4 grados)
-  G4double cosMax = 1.0;                 // cos(0 grados)
-
-  // Generar un nmero aleatorio entre cosMin y cosMax
-  G4double randomNumber = cosMin + (cosMax - cosMin) * G4UniformRand();
-
-  // Calcular el ngulo correspondiente usando arccos (en radianes)
-  G4double theta = std::acos(randomNumber);
-
-  // Generar un ngulo phi aleatorio entre 0 y 360 grados
-  G4double phi = G4UniformRand() * 360.0 * deg;
-
-  // Convertir coordenadas esfricas a cartesianas
-  G4double ux = std::sin(theta) * std::cos(phi);
-  G4double uy = std::sin(theta) * std::sin(phi);
-  G4double uz = std::cos(theta);
-
-  // Establecer la direccin del momento de la partcula
-  fParticleGun->SetParticleMomentumDirection(G4ThreeVector(ux, uy, uz));
-
-  // Generate the primary vertex
-  fParticleGun->GeneratePrimaryVertex(anEvent);
+  fSamplingTime += std::chrono::duration<G4double>(
+    std::chrono::steady_clock::now() - start).count();
 
   /*
   // ngulo del cono
@@ -181,4 +190,596 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void PrimaryGeneratorAction::GenerateGunPrimary(G4Event* anEvent,
+                                                G4long primaryIndex)
+{
+  // The energies, directions and weights are sampled by batches,
+  // which are used over several events;
+  // with QMC, each primary is sampled from its own point
+  if ( fUseQMC ) {
+    SetQMCPoint(primaryIndex);
+    FillBatch(1);
+  }
+  else if ( fBatchIndex >= fBatchCount ) {
+    FillBatch(fBatchSize);
+  }
+  auto i = fBatchIndex++;
+
+  // The sampled energy is set for this primary only;
+  // the gun energy is kept for the next runs
+  auto gunEnergy = fParticleGun->GetParticleEnergy();
+  if ( fUseSpectrum && ! fSpectrum.IsEmpty() ) {
+    fParticleGun->SetParticleEnergy(fBatchEnergy[i]);
+  }
+  fParticleGun->SetParticleMomentumDirection(
+    G4ThreeVector(fBatchDirX[i], fBatchDirY[i], fBatchDirZ[i]));
+
+  // With an energy scan, the energy is sampled in the energy bin
+  // selected for this primary
+  auto scan = EnergyScan::Instance();
+  G4int energyBin = -1;
+  if ( scan->IsActive() ) {
+    energyBin = scan->SelectBin(primaryIndex);
+    fParticleGun->SetParticleEnergy(scan->SampleEnergy(energyBin));
+  }
+
+  // The position is sampled in the spot around the gun position
+  auto gunPosition = fParticleGun->GetParticlePosition();
+  if ( fSpotRadius > 0. ) {
+    fParticleGun->SetParticlePosition(
+      gunPosition + G4ThreeVector(fBatchPosX[i], fBatchPosY[i], 0.));
+  }
+
+  // Generate the primary vertex with the statistical weight
+  fParticleGun->GeneratePrimaryVertex(anEvent);
+  fParticleGun->SetParticlePosition(gunPosition);
+  fParticleGun->SetParticleEnergy(gunEnergy);
+  auto vertex
+    = anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1);
+  vertex->SetWeight(fBatchWeight[i]);
+
+  // Tag the primary with its energy bin
+  if ( energyBin >= 0 ) {
+    vertex->GetPrimary()->SetUserInformation(new PrimaryInfo(energyBin));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GeneratePhaseSpacePrimary(G4Event* anEvent,
+                                                       G4long primaryIndex)
+{
+  // The record and its use depend only on the event ID and on the
+  // primary index in the event, whichever thread runs it
+  auto nofRecords = static_cast<G4long>(fPhaseSpace.GetNofRecords());
+  auto recordIndex = primaryIndex / fPhaseSpaceRecycle;
+  auto use = primaryIndex % fPhaseSpaceRecycle;
+  if ( recordIndex >= nofRecords && ! fPhaseSpaceWrapped ) {
+    fPhaseSpaceWrapped = true;
+    G4ExceptionDescription msg;
+    msg << "All the " << nofRecords
+        << " phase space records were used;" << G4endl;
+    msg << "they are replayed again, the events are no longer independent.";
+    G4Exception("PrimaryGeneratorAction::GeneratePhaseSpacePrimary()",
+      "MyCode0013", JustWarning, msg);
+  }
+
+  const auto& record = fPhaseSpace.GetRecord(
+    static_cast<std::size_t>(recordIndex % nofRecords));
+  G4ThreeVector position(record.fX * mm, record.fY * mm, record.fZ * mm);
+  G4ThreeVector direction(record.fDirX, record.fDirY, record.fDirZ);
+
+  // the recycled records are rotated around the z axis
+  if ( fPhaseSpaceRotate && use > 0 ) {
+    auto angle = G4UniformRand() * CLHEP::twopi;
+    position.rotateZ(angle);
+    direction.rotateZ(angle);
+  }
+
+  fParticleGun->SetParticlePosition(position);
+  fParticleGun->SetParticleMomentumDirection(direction);
+  fParticleGun->SetParticleEnergy(record.fEnergy * MeV);
+  fParticleGun->GeneratePrimaryVertex(anEvent);
+  anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1)
+    ->SetWeight(record.fWeight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::StartRun(G4int runID)
+{
+  // The batches are drawn from a random sub-stream of their own, which
+  // depends only on the batch seed, the run ID and the thread ID:
+  // the leftovers of the previous run are discarded
+  long seeds[] = { fBatchSeed, runID, G4Threading::G4GetThreadId() + 1 };
+  fBatchEngine.setSeeds(seeds, 3);
+  InvalidateBatch();
+
+  fSamplingTime = 0.;
+  fPhaseSpaceWrapped = false;
+  fRunID = runID;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetQMCPoint(G4long primaryIndex)
+{
+  // each run uses its own scrambling of the sequence
+  auto runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+  if ( runID != fQMCRunID ) {
+    fQMC.Scramble((static_cast<std::uint64_t>(fQMCSeed) << 32)
+                  + static_cast<std::uint64_t>(runID));
+    fQMCRunID = runID;
+  }
+
+  // the point depends only on the event ID and on the primary index
+  // in the event, whichever thread runs it
+  fQMCIndex = static_cast<std::uint64_t>(primaryIndex) + 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::DrawUniforms(G4int firstDim, G4int nofDims,
+                                          std::size_t n)
+{
+  // the randoms are stored dimension by dimension: n values per dimension
+  if ( fUseQMC ) {
+    for ( G4int dim = 0; dim < nofDims; ++dim ) {
+      fRandoms[dim] = fQMC.Sample(fQMCIndex, firstDim + dim);
+    }
+    return;
+  }
+  // the batches come from the batch stream, single primaries from
+  // the event random numbers
+  auto engine
+    = ( fBatchSize > 1 ) ? &fBatchEngine : G4Random::getTheEngine();
+  engine->flatArray(static_cast<G4int>(nofDims * n), fRandoms.Data());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::FillBatch(std::size_t n)
+{
+  // the buffers only grow, the batch being the first n entries
+  if ( fBatchDirX.Size() < n ) {
+    fBatchDirX.Resize(n);
+    fBatchDirY.Resize(n);
+    fBatchDirZ.Resize(n);
+    fBatchPosX.Resize(n);
+    fBatchPosY.Resize(n);
+    fBatchEnergy.Resize(n);
+    fBatchWeight.Resize(n);
+    fBatchCosHalfAngle.Resize(n);
+    fRandoms.Resize(3 * n);
+    fBatchCone.resize(n);
+  }
+  // Directions: select the cone of each primary, the analog cone
+  // or one of the biasing cones
+  const auto biased = fBiasDirection && ! fCones.empty();
+  G4double sumProbabilities = 0.;
+  for ( const auto& cone : fCones ) sumProbabilities += cone.fProbability;
+
+  DrawUniforms(kDimCosTheta, biased ? 3 : 2, n);
+  for ( std::size_t i = 0; i < n; ++i ) {
+    fBatchCone[i] = -1;
+    fBatchCosHalfAngle[i] = fCosConeHalfAngle;
+    if ( ! biased ) continue;
+
+    auto r = fRandoms[2 * n + i];
+    if ( r < fAnalogFraction ) continue;
+    r = (r - fAnalogFraction) / (1. - fAnalogFraction) * sumProbabilities;
+    G4int selected = static_cast<G4int>(fCones.size()) - 1;
+    for ( std::size_t k = 0; k < fCones.size(); ++k ) {
+      if ( r < fCones[k].fProbability ) {
+        selected = static_cast<G4int>(k);
+        break;
+      }
+      r -= fCones[k].fProbability;
+    }
+    fBatchCone[i] = selected;
+    fBatchCosHalfAngle[i] = fCones[selected].fCosHalfAngle;
+  }
+
+  SampleConeDirections(n, fRandoms.Data(), fRandoms.Data() + n,
+                       fBatchCosHalfAngle.Data(),
+                       fBatchDirX.Data(), fBatchDirY.Data(), fBatchDirZ.Data());
+
+  // Weights = analog density / mixture density at each direction;
+  // the biasing cones are contained in the analog cone, where the analog
+  // density is uniform
+  for ( std::size_t i = 0; i < n; ++i ) {
+    fBatchWeight[i] = 1.;
+    if ( ! biased ) continue;
+
+    G4ThreeVector direction(fBatchDirX[i], fBatchDirY[i], fBatchDirZ[i]);
+    if ( fBatchCone[i] >= 0 ) {
+      direction.rotateUz(fCones[fBatchCone[i]].fAxis);
+      fBatchDirX[i] = direction.x();
+      fBatchDirY[i] = direction.y();
+      fBatchDirZ[i] = direction.z();
+    }
+
+    auto densityRatio = fAnalogFraction;
+    for ( const auto& cone : fCones ) {
+      if ( direction.dot(cone.fAxis) >= cone.fCosHalfAngle ) {
+        densityRatio += (1. - fAnalogFraction)
+                        * (cone.fProbability / sumProbabilities)
+                        * (1. - fCosConeHalfAngle) / (1. - cone.fCosHalfAngle);
+      }
+    }
+    fBatchWeight[i] = 1. / densityRatio;
+  }
+
+  // Energies
+  if ( fUseSpectrum && ! fSpectrum.IsEmpty() ) {
+    DrawUniforms(kDimEnergy, 2, n);
+    for ( std::size_t i = 0; i < n; ++i ) {
+      fBatchEnergy[i] = fSpectrum.Sample(fRandoms[i], fRandoms[n + i]);
+    }
+  }
+
+  // Positions, uniform in the spot disk
+  if ( fSpotRadius > 0. ) {
+    DrawUniforms(kDimSpot, 2, n);
+    for ( std::size_t i = 0; i < n; ++i ) {
+      auto r = fSpotRadius * std::sqrt(fRandoms[i]);
+      auto phi = fRandoms[n + i] * CLHEP::twopi;
+      fBatchPosX[i] = r * std::cos(phi);
+      fBatchPosY[i] = r * std::sin(phi);
+    }
+  }
+
+  fBatchCount = n;
+  fBatchIndex = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetBatchSize(G4int batchSize)
+{
+  fBatchSize = static_cast<std::size_t>(std::max(batchSize, 1));
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetSampling(const G4String& mode)
+{
+  fUseQMC = ( mode == "qmc" );
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetQMCSeed(G4int seed)
+{
+  fQMCSeed = seed;
+  fQMCRunID = -1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetNofPrimaries(G4int nofPrimaries)
+{
+  fNofPrimaries = std::max(nofPrimaries, 1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetSpotRadius(G4double radius)
+{
+  fSpotRadius = radius;
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetAnalogFraction(G4double fraction)
+{
+  fAnalogFraction = fraction;
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetDirectionMode(const G4String& mode)
+{
+  fBiasDirection = ( mode == "biased" );
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::AddCone(const G4String& cone)
+{
+  // cone = "x y z halfAngle probability", target point in cm, angle in deg
+  std::istringstream is(cone);
+  G4double x = 0., y = 0., z = 0., halfAngle = 0., probability = 0.;
+  if ( ! ( is >> x >> y >> z >> halfAngle >> probability ) ||
+       halfAngle <= 0. || probability <= 0. ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot read \"x y z halfAngle probability\" from \""
+        << cone << "\"." << G4endl;
+    msg << "The cone was not added.";
+    G4Exception("PrimaryGeneratorAction::AddCone()",
+      "MyCode0011", JustWarning, msg);
+    return;
+  }
+
+  auto axis
+    = (G4ThreeVector(x, y, z) * cm - fParticleGun->GetParticlePosition()).unit();
+  halfAngle *= deg;
+
+  // the weights are correct only for sub-cones inside the analog cone
+  if ( axis.angle(G4ThreeVector(0., 0., 1.)) + halfAngle > kConeHalfAngle ) {
+    G4ExceptionDescription msg;
+    msg << "The cone \"" << cone << "\" is not contained in the "
+        << kConeHalfAngle / deg << " deg source cone." << G4endl;
+    msg << "The cone was not added.";
+    G4Exception("PrimaryGeneratorAction::AddCone()",
+      "MyCode0011", JustWarning, msg);
+    return;
+  }
+
+  fCones.push_back({ axis, std::cos(halfAngle), probability });
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::ClearCones()
+{
+  fCones.clear();
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetEnergyMode(const G4String& mode)
+{
+  fUseSpectrum = ( mode == "spectrum" );
+  InvalidateBatch();
+  if ( fUseSpectrum && fSpectrum.IsEmpty() ) {
+    G4ExceptionDescription msg;
+    msg << "No energy spectrum is loaded." << G4endl;
+    msg << "The gun energy is used until one is set with "
+        << "/phantom/source/spectrum.";
+    G4Exception("PrimaryGeneratorAction::SetEnergyMode()",
+      "MyCode0012", JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetSpectrum(const G4String& spectrum)
+{
+  G4bool loaded = true;
+  if ( spectrum == "watt-cf252" ) {
+    // Cf-252 spontaneous fission: a = 1.025 MeV, b = 2.926 /MeV
+    fSpectrum.SetWatt(1.025 * MeV, 2.926 / MeV, 20. * MeV, 2000);
+  }
+  else {
+    loaded = fSpectrum.Load(spectrum);
+  }
+
+  if ( loaded ) fUseSpectrum = true;
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetSourceType(const G4String& type)
+{
+  auto usePhaseSpace = ( type == "phaseSpace" );
+  if ( usePhaseSpace == fUsePhaseSpace ) return;
+
+  // the phase space records overwrite the gun position
+  if ( usePhaseSpace ) {
+    fGunPosition = fParticleGun->GetParticlePosition();
+  }
+  else {
+    fParticleGun->SetParticlePosition(fGunPosition);
+  }
+  fUsePhaseSpace = usePhaseSpace;
+  InvalidateBatch();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetPhaseSpaceFile(const G4String& fileName)
+{
+  if ( ! fPhaseSpace.Open(fileName) ) return;
+
+  // the records are selected by the primary index
+  // (see GeneratePhaseSpacePrimary())
+  fPhaseSpaceWrapped = false;
+
+  G4cout
+    << "--> Phase space " << fileName << ": "
+    << fPhaseSpace.GetNofRecords() << " records" << G4endl;
+
+  SetSourceType("phaseSpace");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::DefineCommands()
+{
+  // Define /phantom/source command directory using generic messenger class
+  fMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/source/",
+                             "Primary source control");
+
+  // direction command
+  auto& directionCmd
+    = fMessenger->DeclareMethod("direction",
+                                &PrimaryGeneratorAction::SetDirectionMode,
+                                "Select the direction sampling:\n"
+                                " analog - uniform in the 8 deg cone\n"
+                                " biased - mixture of the uniform cone and "
+                                "of the cones added with addCone;\n"
+                                "          the primaries carry the "
+                                "matching statistical weight");
+  directionCmd.SetParameterName("mode", false);
+  directionCmd.SetCandidates("analog biased");
+  directionCmd.SetDefaultValue("analog");
+
+  // addCone command
+  auto& addConeCmd
+    = fMessenger->DeclareMethod("addCone",
+                                &PrimaryGeneratorAction::AddCone,
+                                "Add a biasing cone: \"x y z halfAngle "
+                                "probability\",\npointing from the source "
+                                "to the target point (x, y, z) in cm,\n"
+                                "with the half angle in deg; it must be "
+                                "contained in the 8 deg cone.");
+  addConeCmd.SetParameterName("cone", false);
+
+  // clearCones command
+  fMessenger->DeclareMethod("clearCones",
+                            &PrimaryGeneratorAction::ClearCones,
+                            "Remove all biasing cones.");
+
+  // analogFraction command
+  auto& fractionCmd
+    = fMessenger->DeclareMethod("analogFraction",
+                                &PrimaryGeneratorAction::SetAnalogFraction,
+                                "Set the fraction of the primaries sampled "
+                                "uniformly in the 8 deg cone\n"
+                                "in the biased mode; it must be positive "
+                                "for the whole cone to be covered.");
+  fractionCmd.SetParameterName("fraction", false);
+  fractionCmd.SetRange("fraction>0. && fraction<=1.");
+
+  // spectrum command
+  auto& spectrumCmd
+    = fMessenger->DeclareMethod("spectrum",
+                                &PrimaryGeneratorAction::SetSpectrum,
+                                "Load the neutron energy spectrum and use it:\n"
+                                " watt-cf252 - Cf-252 Watt fission spectrum\n"
+                                " fileName   - text (\"Elo Ehi weight\" per "
+                                "line, MeV) or binary spectrum table\n"
+                                "              (see B4::EnergySpectrum)");
+  spectrumCmd.SetParameterName("spectrum", false);
+
+  // energyMode command
+  auto& energyModeCmd
+    = fMessenger->DeclareMethod("energyMode",
+                                &PrimaryGeneratorAction::SetEnergyMode,
+                                "Select the neutron energy:\n"
+                                " mono     - the gun energy (/gun/energy)\n"
+                                " spectrum - sampled from the loaded spectrum");
+  energyModeCmd.SetParameterName("mode", false);
+  energyModeCmd.SetCandidates("mono spectrum");
+  energyModeCmd.SetDefaultValue("mono");
+
+  // batchSize command
+  auto& batchSizeCmd
+    = fMessenger->DeclareMethod("batchSize",
+                                &PrimaryGeneratorAction::SetBatchSize,
+                                "Set the number of primaries sampled at "
+                                "once, over several events,\nfrom the "
+                                "random stream of the thread (see "
+                                "batchSeed);\n1 samples each primary from "
+                                "the event random numbers.");
+  batchSizeCmd.SetParameterName("n", false);
+  batchSizeCmd.SetRange("n>=1");
+  batchSizeCmd.SetDefaultValue("256");
+
+  // batchSeed command
+  auto& batchSeedCmd
+    = fMessenger->DeclareProperty("batchSeed",
+                                  fBatchSeed,
+                                  "Set the seed of the batch random stream;\n"
+                                  "it is combined with the run ID and the "
+                                  "thread ID.");
+  batchSeedCmd.SetParameterName("seed", false);
+  batchSeedCmd.SetRange("seed>=0");
+
+  // primariesPerEvent command
+  auto& nofPrimariesCmd
+    = fMessenger->DeclareMethod("primariesPerEvent",
+                                &PrimaryGeneratorAction::SetNofPrimaries,
+                                "Set the number of independent primaries "
+                                "per event;\nthe detector values are still "
+                                "accounted per primary.");
+  nofPrimariesCmd.SetParameterName("n", false);
+  nofPrimariesCmd.SetRange("n>=1");
+  nofPrimariesCmd.SetDefaultValue("1");
+
+  // sampling command
+  auto& samplingCmd
+    = fMessenger->DeclareMethod("sampling",
+                                &PrimaryGeneratorAction::SetSampling,
+                                "Select the random numbers of the source "
+                                "(direction, energy, spot):\n"
+                                " pseudo - the Geant4 random engine\n"
+                                " qmc    - a scrambled Halton sequence, "
+                                "one point per primary");
+  samplingCmd.SetParameterName("mode", false);
+  samplingCmd.SetCandidates("pseudo qmc");
+  samplingCmd.SetDefaultValue("pseudo");
+
+  // qmcSeed command
+  auto& qmcSeedCmd
+    = fMessenger->DeclareMethod("qmcSeed",
+                                &PrimaryGeneratorAction::SetQMCSeed,
+                                "Set the seed of the Halton sequence "
+                                "scrambling;\nit is combined with the run ID.");
+  qmcSeedCmd.SetParameterName("seed", false);
+  qmcSeedCmd.SetRange("seed>=0");
+
+  // spotRadius command
+  auto& spotRadiusCmd
+    = fMessenger->DeclareMethodWithUnit("spotRadius", "mm",
+                                        &PrimaryGeneratorAction::SetSpotRadius,
+                                        "Set the radius of the source spot, "
+                                        "a disk around the gun position\n"
+                                        "perpendicular to the z axis; "
+                                        "0 for a point source.");
+  spotRadiusCmd.SetParameterName("radius", false);
+  spotRadiusCmd.SetRange("radius>=0.");
+
+  // type command
+  auto& typeCmd
+    = fMessenger->DeclareMethod("type",
+                                &PrimaryGeneratorAction::SetSourceType,
+                                "Select the source:\n"
+                                " gun        - the particle gun with the "
+                                "direction and energy options above\n"
+                                " phaseSpace - the records of the phase "
+                                "space file");
+  typeCmd.SetParameterName("type", false);
+  typeCmd.SetCandidates("gun phaseSpace");
+  typeCmd.SetDefaultValue("gun");
+
+  // phaseSpaceFile command
+  auto& phaseSpaceFileCmd
+    = fMessenger->DeclareMethod("phaseSpaceFile",
+                                &PrimaryGeneratorAction::SetPhaseSpaceFile,
+                                "Map the phase space file and replay it "
+                                "as the source.");
+  phaseSpaceFileCmd.SetParameterName("fileName", false);
+
+  // phaseSpaceRecycle command
+  auto& recycleCmd
+    = fMessenger->DeclareProperty("phaseSpaceRecycle",
+                                  fPhaseSpaceRecycle,
+                                  "Use each phase space record n times.");
+  recycleCmd.SetParameterName("n", false);
+  recycleCmd.SetRange("n>=1");
+
+  // phaseSpaceRotate command
+  auto& rotateCmd
+    = fMessenger->DeclareProperty("phaseSpaceRotate",
+                                  fPhaseSpaceRotate,
+                                  "Rotate the recycled phase space records by "
+                                  "a random angle around the z axis.");
+  rotateCmd.SetParameterName("rotate", true);
+  rotateCmd.SetDefaultValue("true");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 }
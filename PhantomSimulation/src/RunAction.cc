@@ -28,19 +28,31 @@
 /// \brief Implementation of the B4::RunAction class
 
 #include "RunAction.hh"
+#include "EnergyScan.hh"
+#include "PhaseSpaceWriter.hh"
+#include "PhysicsTableCache.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "StartupMonitor.hh"
 
+#include "G4AccumulableManager.hh"
 #include "G4AnalysisManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4LogicalVolumeStore.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <iomanip>
+#include <string>
+
 namespace B4
 {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-RunAction::RunAction()
+RunAction::RunAction(G4bool pulseHeightSpectra)
+ : fPulseHeightSpectra(pulseHeightSpectra)
 {
   // set printing event number per each event
   G4RunManager::GetRunManager()->SetPrintProgress(1);
@@ -57,29 +69,76 @@ RunAction::RunAction()
   analysisManager->SetNtupleMerging(true);
     // Note: merging ntuples is available only with Root output
 
+  // Default output file, which can be changed with /analysis/setFileName
+  // The choice of the output format is done via the specified
+  // file extension. Other supported output types:
+  // B4.csv, B4.hdf5, B4.xml
+  analysisManager->SetFileName("B4.root");
+
   // Book histograms, ntuple
   //
 
   
   
   // Creating histograms
-  analysisManager->CreateH1("EDetector", "Edep in detector", 300, 0., 3 * MeV);
-  analysisManager->CreateH1("LDetector", "trackL in detector", 100, 0., 30 * cm);
+  // (the detector spectra are not booked with importance biasing)
+  if ( fPulseHeightSpectra ) {
+    analysisManager->CreateH1("EDetector", "Edep in detector", 300, 0., 3 * MeV);
+    analysisManager->CreateH1("LDetector", "trackL in detector", 100, 0., 30 * cm);
+  }
 
   //Queremos crear un histograma de las posiciones X e Y de las particulas que llegan al detector
-  analysisManager->CreateH2("h2", "Posiciones de las particulas en el detector", 300., -100., 100., 300., -100., 100.);
+  analysisManager->CreateH2("h2", "Posiciones de las particulas en el detector",
+                            kImageNbins, kImageMin, kImageMax,
+                            kImageNbins, kImageMin, kImageMax);
   
 
   // Creating ntuple
   //
-  analysisManager->CreateNtuple("B4", "Edep, TrackL and positions");
-  analysisManager->CreateNtupleDColumn("EDetector");
-  analysisManager->CreateNtupleDColumn("LDetector");
-  analysisManager->FinishNtuple();
+  if ( fPulseHeightSpectra ) {
+    analysisManager->CreateNtuple("B4", "Edep, TrackL and positions");
+    analysisManager->CreateNtupleDColumn("EDetector");
+    analysisManager->CreateNtupleDColumn("LDetector");
+    analysisManager->CreateNtupleDColumn("Weight");
+    analysisManager->CreateNtupleIColumn("EnergyBin");
+    analysisManager->FinishNtuple();
+  }
+
+  // Register the image accumulables to the accumulable manager
+  auto accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->RegisterAccumulable(&fImage);
+  accumulableManager->RegisterAccumulable(&fCube);
+  accumulableManager->RegisterAccumulable(&fPixels);
+  accumulableManager->RegisterAccumulable(fSumEdep);
+  accumulableManager->RegisterAccumulable(fSumTrackL);
+  accumulableManager->RegisterAccumulable(fSumWeight);
+  accumulableManager->RegisterAccumulable(fNofPrimaries);
+  accumulableManager->RegisterAccumulable(fNofSteps);
+  accumulableManager->RegisterAccumulable(fSamplingTime);
+  accumulableManager->RegisterAccumulable(fNofKilledTracks);
+  accumulableManager->RegisterAccumulable(fNofDeferredTracks);
+  accumulableManager->RegisterAccumulable(&fKillZoneTally);
+  accumulableManager->RegisterAccumulable(&fScoringCurrentTally);
+  accumulableManager->RegisterAccumulable(&fScoringTrackLengthTally);
+
+  // Define commands for this class
+  DefineCommands();
+
+  // Create the energy scan with its commands
+  EnergyScan::Instance();
  
   
   
 
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunAction::~RunAction()
+{
+  delete fMessenger;
+  delete fPhaseSpaceMessenger;
+  delete fPixelMessenger;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -89,28 +148,86 @@ void RunAction::BeginOfRunAction(const G4Run* /*run*/)
   //inform the runManager to save random number seed
   //G4RunManager::GetRunManager()->SetRandomNumberStore(true);
 
+  // record the startup cost (first run only), store the physics tables
+  // built for a new cache key, and start the run timer
+  if ( isMaster ) {
+    StartupMonitor::Instance()->BeginOfRun();
+    PhysicsTableCache::Instance()->BeginOfRun();
+    fTimer.Start();
+  }
+
+  // (re)allocate the image cube for the current layout
+  SetCubeLayout();
+
+  // the pixels are allocated by the detector sensitive detector
+  // for the current geometry, with the current spectrum binning
+  fPixels.Clear();
+  fPixels.SetSpectrum(fPixelNbinsE, fPixelEmax);
+
+  // open the phase space file when the geometry has a phase space plane
+  if ( isMaster &&
+       G4LogicalVolumeStore::GetInstance()->GetVolume("PhaseSpacePlane", false) ) {
+    PhaseSpaceWriter::Instance()->Open(fPhaseSpaceFileName);
+  }
+
+  // book the energy slices of the current energy scan
+  BookEnergySlices();
+
+  // reset accumulables to their initial values
+  G4AccumulableManager::Instance()->Reset();
+
   // Get analysis manager
   auto analysisManager = G4AnalysisManager::Instance();
 
   // Open an output file
   //
-  G4String fileName = "B4.root";
-  // Other supported output types:
-  // G4String fileName = "B4.csv";
-  // G4String fileName = "B4.hdf5";
-  // G4String fileName = "B4.xml";
-  analysisManager->OpenFile(fileName);
+  analysisManager->OpenFile();
   G4cout << "Using " << analysisManager->GetType() << G4endl;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void RunAction::EndOfRunAction(const G4Run* /*run*/)
+void RunAction::EndOfRunAction(const G4Run* run)
 {
+  // collect the source sampling time of this thread
+  auto generatorAction = static_cast<const PrimaryGeneratorAction*>(
+    G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction());
+  if ( generatorAction ) {
+    fSamplingTime += generatorAction->GetSamplingTime();
+  }
+
+  // Merge accumulables
+  G4AccumulableManager::Instance()->Merge();
+
+  // print the run throughput and the startup cost
+  if ( isMaster ) {
+    fTimer.Stop();
+    auto nofEvents = run->GetNumberOfEvent();
+    auto realTime = fTimer.GetRealElapsed();
+    G4cout
+      << G4endl
+      << " Run " << run->GetRunID() << ": " << nofEvents << " events in "
+      << realTime << " s";
+    if ( realTime > 0. ) {
+      G4cout << " (" << nofEvents / realTime << " events/s, "
+             << fNofPrimaries.GetValue() / realTime << " primaries/s, "
+             << fNofSteps.GetValue() / realTime << " steps/s)";
+    }
+    G4cout << G4endl;
+    if ( fNofPrimaries.GetValue() > 0 ) {
+      G4cout
+        << " Source sampling: "
+        << 1.e9 * fSamplingTime.GetValue() / fNofPrimaries.GetValue()
+        << " ns per primary (summed over the threads)" << G4endl;
+    }
+    StartupMonitor::Instance()->Print();
+    PhysicsTableCache::Instance()->Print();
+  }
+
   // print histogram statistics
   //
   auto analysisManager = G4AnalysisManager::Instance();
-  if ( analysisManager->GetH1(1)) { //aqui he aadido analysisManager->GetH2(1) no se si esta bien
+  if ( fPulseHeightSpectra && analysisManager->GetH1(1)) { //aqui he aadido analysisManager->GetH2(1) no se si esta bien
     G4cout << G4endl << " ----> print histograms statistic ";
     if(isMaster) {
       G4cout << "for the entire run " << G4endl << G4endl;
@@ -134,6 +251,79 @@ void RunAction::EndOfRunAction(const G4Run* /*run*/)
   }
   
 
+  // print only the means of the weighted detector totals
+  if ( ! fPulseHeightSpectra && isMaster && fSumWeight.GetValue() > 0. ) {
+    G4cout
+      << G4endl
+      << " Detector totals per unit primary weight (importance biasing,"
+      << " no spectra):" << G4endl
+      << " EDetector : mean = "
+      << G4BestUnit(fSumEdep.GetValue() / fSumWeight.GetValue(), "Energy")
+      << G4endl
+      << " LDetector : mean = "
+      << G4BestUnit(fSumTrackL.GetValue() / fSumWeight.GetValue(), "Length")
+      << G4endl;
+  }
+
+  // print the secondary tracks suppressed by the stacking action
+  if ( isMaster ) {
+    G4cout
+      << G4endl
+      << " Stacking: " << fNofKilledTracks.GetValue()
+      << " secondary tracks killed, " << fNofDeferredTracks.GetValue()
+      << " deferred" << G4endl;
+    fKillZoneTally.PrintTallies("Kill zones: neutrons killed per zone");
+    fScoringCurrentTally.PrintTallies(
+      "Scoring world: neutrons entering per volume");
+    fScoringTrackLengthTally.PrintTallies(
+      "Scoring world: neutron steps and track length [mm] per volume");
+  }
+
+  // print the energy slices statistics
+  auto scan = EnergyScan::Instance();
+  if ( isMaster && scan->IsActive() ) {
+    G4cout << G4endl << " Energy scan: " << G4endl;
+    for ( G4int i = 0; i < scan->GetNofBins(); ++i ) {
+      G4cout << "  " << std::setw(3) << i << ": " << scan->GetBinLabel(i);
+      if ( fPulseHeightSpectra ) {
+        auto h1 = analysisManager->GetH1(fSliceEDetectorIds[i]);
+        G4cout
+          << " " << h1->entries() << " primaries, EDetector mean = "
+          << G4BestUnit(h1->mean(), "Energy");
+      }
+      else {
+        G4cout << " image sum = " << fSliceImages[i]->GetSum();
+      }
+      G4cout << G4endl;
+    }
+  }
+
+  // write the phase space records of this thread;
+  // the master closes the file after all threads
+  PhaseSpaceWriter::Instance()->Flush();
+  if ( isMaster ) PhaseSpaceWriter::Instance()->Close();
+
+  // export the merged image to the h2 histogram
+  // and write the merged image cube
+  if ( isMaster ) {
+    fImage.FillH2(0);
+    for ( std::size_t i = 0; i < fSliceImages.size(); ++i ) {
+      fSliceImages[i]->FillH2(fSliceH2Ids[i]);
+    }
+
+    if ( fCube.IsActive() && fCube.Write(fCubeFileName) ) {
+      G4cout << " Image cube (x, y, E) written in " << fCubeFileName
+             << G4endl;
+    }
+
+    if ( fPixels.IsActive() && fPixels.Write(fPixelFileName) ) {
+      G4cout << " Detector pixels ("
+             << fPixels.GetNofPixelsX() << " x " << fPixels.GetNofPixelsY()
+             << ", " << fPixels.GetMemorySize() / (1024. * 1024.)
+             << " MB) written in " << fPixelFileName << G4endl;
+    }
+  }
+
   // save histograms & ntuple
   //
   analysisManager->Write();
@@ -142,4 +332,200 @@ void RunAction::EndOfRunAction(const G4Run* /*run*/)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void RunAction::SetCubeLayout()
+{
+  if ( ! fCubeEnabled ) {
+    fCube.Clear();
+    return;
+  }
+
+  auto nofBins
+    = static_cast<std::size_t>(fCubeNbinsXY) * fCubeNbinsXY * fCubeNbinsE;
+  if ( fCubeNbinsXY <= 0 || fCubeNbinsE <= 0 || fCubeEmin <= 0. ||
+       fCubeEmax <= fCubeEmin || nofBins > kCubeMaxBins ) {
+    G4ExceptionDescription msg;
+    msg << "Invalid image cube layout: "
+        << fCubeNbinsXY << " x " << fCubeNbinsXY << " x " << fCubeNbinsE
+        << " bins, energy range "
+        << G4BestUnit(fCubeEmin, "Energy") << " - "
+        << G4BestUnit(fCubeEmax, "Energy") << G4endl;
+    msg << "The image cube is disabled for this run.";
+    G4Exception("RunAction::SetCubeLayout()",
+      "MyCode0007", JustWarning, msg);
+    fCube.Clear();
+    return;
+  }
+
+  fCube.SetLayout(fCubeNbinsXY, kImageMin, kImageMax,
+                  fCubeNbinsE, fCubeEmin, fCubeEmax);
+
+  if ( isMaster ) {
+    G4cout << " Image cube: "
+           << fCubeNbinsXY << " x " << fCubeNbinsXY << " x " << fCubeNbinsE
+           << " bins, " << fCube.GetMemorySize() / (1024. * 1024.)
+           << " MB per thread" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::BookEnergySlices()
+{
+  // The slices are booked in the same order on the master and on the
+  // workers, so that the histograms and the images are merged by index.
+  // They are kept when the scan shrinks, and then stay empty.
+  auto nofBins = static_cast<std::size_t>(EnergyScan::Instance()->GetNofBins());
+  auto analysisManager = G4AnalysisManager::Instance();
+  auto accumulableManager = G4AccumulableManager::Instance();
+
+  for ( auto i = fSliceImages.size(); i < nofBins; ++i ) {
+    auto suffix = "_" + std::to_string(i);
+    auto title = ", energy bin " + std::to_string(i);
+
+    if ( fPulseHeightSpectra ) {
+      fSliceEDetectorIds.push_back(
+        analysisManager->CreateH1("EDetector" + suffix, "Edep in detector" + title,
+                                  300, 0., 3 * MeV));
+      fSliceLDetectorIds.push_back(
+        analysisManager->CreateH1("LDetector" + suffix, "trackL in detector" + title,
+                                  100, 0., 30 * cm));
+    }
+    fSliceH2Ids.push_back(
+      analysisManager->CreateH2("h2" + suffix,
+                                "Posiciones de las particulas en el detector"
+                                + title,
+                                kImageNbins, kImageMin, kImageMax,
+                                kImageNbins, kImageMin, kImageMax));
+
+    fSliceImages.push_back(std::make_unique<ImageAccumulable>(
+      "h2" + suffix,
+      kImageNbins, kImageMin, kImageMax,
+      kImageNbins, kImageMin, kImageMax));
+    accumulableManager->RegisterAccumulable(fSliceImages.back().get());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::FillSlice(G4int bin, G4double energy, G4double trackL,
+                          G4double weight)
+{
+  if ( bin < 0 || bin >= static_cast<G4int>(fSliceEDetectorIds.size()) ) return;
+
+  auto analysisManager = G4AnalysisManager::Instance();
+  analysisManager->FillH1(fSliceEDetectorIds[bin], energy, weight);
+  analysisManager->FillH1(fSliceLDetectorIds[bin], trackL, weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::DefineCommands()
+{
+  // Define /phantom/image/cube command directory using generic messenger class
+  fMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/image/cube/",
+                             "Energy resolved (x, y, E) image cube control");
+
+  // enable command
+  auto& enableCmd
+    = fMessenger->DeclareProperty("enable", fCubeEnabled,
+                                  "Accumulate the (x, y, E) image cube.");
+  enableCmd.SetParameterName("enable", true);
+  enableCmd.SetDefaultValue("true");
+
+  // nbinsXY command
+  auto& nbinsXYCmd
+    = fMessenger->DeclareProperty("nbinsXY", fCubeNbinsXY,
+                                  "Number of x and y bins "
+                                  "(over the h2 range).");
+  nbinsXYCmd.SetParameterName("nbinsXY", false);
+  nbinsXYCmd.SetRange("nbinsXY>0");
+
+  // nbinsE command
+  auto& nbinsECmd
+    = fMessenger->DeclareProperty("nbinsE", fCubeNbinsE,
+                                  "Number of log spaced energy bins.");
+  nbinsECmd.SetParameterName("nbinsE", false);
+  nbinsECmd.SetRange("nbinsE>0");
+
+  // eMin command
+  auto& eMinCmd
+    = fMessenger->DeclarePropertyWithUnit("eMin", "eV", fCubeEmin,
+                                          "Lower edge of the energy axis.");
+  eMinCmd.SetParameterName("eMin", false);
+  eMinCmd.SetRange("eMin>0.");
+
+  // eMax command
+  auto& eMaxCmd
+    = fMessenger->DeclarePropertyWithUnit("eMax", "MeV", fCubeEmax,
+                                          "Upper edge of the energy axis.");
+  eMaxCmd.SetParameterName("eMax", false);
+  eMaxCmd.SetRange("eMax>0.");
+
+  // fileName command
+  fMessenger->DeclareProperty("fileName", fCubeFileName,
+                              "Output file of the image cube.");
+
+  // Define /phantom/phasespace command directory using generic messenger class
+  fPhaseSpaceMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/phasespace/",
+                             "Phase space file writing control");
+
+  // fileName command
+  auto& phaseSpaceFileCmd
+    = fPhaseSpaceMessenger->DeclareProperty("fileName", fPhaseSpaceFileName,
+                                            "Output file of the neutrons "
+                                            "crossing the phase space plane.");
+  phaseSpaceFileCmd.SetToBeBroadcasted(false);
+
+  // killRecorded command
+  auto& killRecordedCmd
+    = fPhaseSpaceMessenger->DeclareMethod("killRecorded",
+                                          &RunAction::SetPhaseSpaceKillRecorded,
+                                          "Kill the neutrons once they are "
+                                          "written in the phase space file.");
+  killRecordedCmd.SetParameterName("kill", true);
+  killRecordedCmd.SetDefaultValue("true");
+  killRecordedCmd.SetToBeBroadcasted(false);
+
+  // Define /phantom/image/pixels command directory using generic messenger class
+  fPixelMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/image/pixels/",
+                             "Pixelated detector readout control");
+
+  // nbinsE command
+  auto& pixelNbinsECmd
+    = fPixelMessenger->DeclareProperty("nbinsE", fPixelNbinsE,
+                                       "Number of bins of the pixel pulse "
+                                       "height spectra.");
+  pixelNbinsECmd.SetParameterName("nbinsE", false);
+  pixelNbinsECmd.SetRange("nbinsE>0");
+
+  // eMax command
+  auto& pixelEmaxCmd
+    = fPixelMessenger->DeclarePropertyWithUnit("eMax", "MeV", fPixelEmax,
+                                               "Upper edge of the pixel pulse "
+                                               "height spectra.");
+  pixelEmaxCmd.SetParameterName("eMax", false);
+  pixelEmaxCmd.SetRange("eMax>0.");
+
+  // fileName command
+  auto& pixelFileCmd
+    = fPixelMessenger->DeclareProperty("fileName", fPixelFileName,
+                                       "Output file of the detector pixels.");
+  pixelFileCmd.SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void RunAction::SetPhaseSpaceKillRecorded(G4bool value)
+{
+  PhaseSpaceWriter::Instance()->SetKillRecorded(value);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 }
@@ -24,71 +24,64 @@
 // ********************************************************************
 //
 //
-/// \file B4/B4a/src/SteppingAction.cc
-/// \brief Implementation of the B4a::SteppingAction class
+/// \file B4/B4a/src/ScoringSD.cc
+/// \brief Implementation of the B4a::ScoringSD class
 
-#include "SteppingAction.hh"
-#include "EventAction.hh"
-#include "DetectorConstruction.hh"
-#include "G4AnalysisManager.hh"
+#include "ScoringSD.hh"
+#include "TallyAccumulable.hh"
 
+#include "G4AccumulableManager.hh"
+#include "G4Neutron.hh"
 #include "G4Step.hh"
-#include "G4RunManager.hh"
-
-using namespace B4;
+#include "G4SystemOfUnits.hh"
+#include "G4VPhysicalVolume.hh"
 
 namespace B4a
 {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-SteppingAction::SteppingAction(const DetectorConstruction* detConstruction,
-                               EventAction* eventAction)
-  : fDetConstruction(detConstruction),
-    fEventAction(eventAction)
+ScoringSD::ScoringSD(const G4String& name)
+ : G4VSensitiveDetector(name)
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void SteppingAction::UserSteppingAction(const G4Step* step)
+void ScoringSD::Initialize(G4HCofThisEvent*)
 {
+  // Get the thread local scoring tallies (only once)
+  if ( ! fCurrentTally ) {
+    auto accumulableManager = G4AccumulableManager::Instance();
+    fCurrentTally = static_cast<B4::TallyAccumulable*>(
+      accumulableManager->GetAccumulable("ScoringCurrent"));
+    fTrackLengthTally = static_cast<B4::TallyAccumulable*>(
+      accumulableManager->GetAccumulable("ScoringTrackLength"));
+  }
+}
 
-// Collect energy and track length step by step
-
-  // get volume of the current step
-  auto volume = step->GetPreStepPoint()->GetTouchableHandle()->GetVolume();
-
-  // energy deposit
-  auto edep = step->GetTotalEnergyDeposit();
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  auto particle = step->GetTrack()->GetDefinition();
+G4bool ScoringSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  if ( step->GetTrack()->GetDefinition() != G4Neutron::Definition() ) {
+    return false;
+  }
 
-  G4ThreeVector position = step->GetPostStepPoint()->GetPosition();
+  // the step points are those of the scoring world
+  auto preStepPoint = step->GetPreStepPoint();
+  auto weight = preStepPoint->GetWeight();
+  const auto& name = preStepPoint->GetPhysicalVolume()->GetName();
 
-  // step length
-  G4double stepLength = 0.;
-  if ( step->GetTrack()->GetDefinition()->GetPDGCharge() == 0. && particle->GetPDGEncoding() == 2112 ) {
-    stepLength = step->GetStepLength();
+  if ( fCurrentTally && preStepPoint->GetStepStatus() == fGeomBoundary ) {
+    fCurrentTally->Add(name, weight);
   }
-
-  if (volume == fDetConstruction->GetDetectorPhys() ) {
-      fEventAction->AddDetector(edep, stepLength);
+  if ( fTrackLengthTally ) {
+    fTrackLengthTally->Add(name, weight * step->GetStepLength() / mm);
   }
 
-  if (particle->GetPDGEncoding() == 2112) {
-    if (volume == fDetConstruction->GetDetectorPhys()) {
-          G4double x = step->GetPreStepPoint()->GetPosition().x();
-          G4double y = step->GetPreStepPoint()->GetPosition().y();
-
-          auto analysisManager = G4AnalysisManager::Instance();
-          analysisManager->FillH2(0, -x, y);
-      }
-  }
-  
+  return true;
 }
 
-
-
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 }
@@ -0,0 +1,166 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/ScoringWorldConstruction.cc
+/// \brief Implementation of the B4::ScoringWorldConstruction class
+
+#include "ScoringWorldConstruction.hh"
+#include "ScoringWorldMessenger.hh"
+#include "ScoringSD.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VSolid.hh"
+#include "G4ios.hh"
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ScoringWorldConstruction::ScoringWorldConstruction(const G4String& worldName)
+ : G4VUserParallelWorld(worldName)
+{
+  fMessenger = new ScoringWorldMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ScoringWorldConstruction::~ScoringWorldConstruction()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorldConstruction::Construct()
+{
+  auto ghostWorldLV = GetWorld()->GetLogicalVolume();
+  G4ThreeVector worldMin, worldMax;
+  ghostWorldLV->GetSolid()->BoundingLimits(worldMin, worldMax);
+
+  fScoringLVs.clear();
+  for ( const auto& volume : fScoringVolumes ) {
+    auto halfSize = volume.fHalfSize;
+    if ( volume.fIsPlane ) {
+      halfSize.setX(worldMax.x());
+      halfSize.setY(worldMax.y());
+    }
+
+    auto name = "Scoring_" + volume.fName;
+    auto scoringBox = new G4Box(name, halfSize.x(), halfSize.y(), halfSize.z());
+    auto scoringLV = new G4LogicalVolume(scoringBox, nullptr, name);
+    new G4PVPlacement(nullptr,           // no rotation
+                      volume.fCenter,    // its position
+                      scoringLV,         // its logical volume
+                      name,              // its name
+                      ghostWorldLV,      // its mother volume
+                      false,             // no boolean operation
+                      0);                // copy number
+    fScoringLVs.push_back(scoringLV);
+  }
+
+  G4cout
+    << "--> " << fScoringVolumes.size() << " scoring volume(s) placed in "
+    << GetName() << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorldConstruction::ConstructSD()
+{
+  if ( fScoringLVs.empty() ) return;
+
+  // The sensitive detector is created once per thread and attached
+  // to the volumes of each new geometry
+  auto sdManager = G4SDManager::GetSDMpointer();
+  auto scoringSD = sdManager->FindSensitiveDetector("ScoringSD", false);
+  if ( ! scoringSD ) {
+    scoringSD = new B4a::ScoringSD("ScoringSD");
+    sdManager->AddNewDetector(scoringSD);
+  }
+  for ( auto scoringLV : fScoringLVs ) {
+    SetSensitiveDetector(scoringLV, scoringSD);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ScoringWorldConstruction::AddBox(const G4String& name,
+                                      const G4ThreeVector& center,
+                                      const G4ThreeVector& halfSize)
+{
+  for ( const auto& volume : fScoringVolumes ) {
+    if ( volume.fName == name ) {
+      G4ExceptionDescription msg;
+      msg << "Scoring volume " << name << " is already defined." << G4endl;
+      msg << "The command is ignored.";
+      G4Exception("ScoringWorldConstruction::AddBox()",
+        "MyCode0019", JustWarning, msg);
+      return false;
+    }
+  }
+
+  fScoringVolumes.push_back({ name, center, halfSize, false });
+  GeometryHasChanged();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorldConstruction::AddPlane(const G4String& name, G4double z)
+{
+  // the x, y extent is set to the world size in Construct()
+  const G4double halfThickness = 0.5 * mm;
+  if ( AddBox(name, G4ThreeVector(0., 0., z),
+              G4ThreeVector(0., 0., halfThickness)) ) {
+    fScoringVolumes.back().fIsPlane = true;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorldConstruction::Clear()
+{
+  fScoringVolumes.clear();
+  GeometryHasChanged();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorldConstruction::GeometryHasChanged()
+{
+  // the parallel worlds are only rebuilt when the geometry is destroyed
+  G4RunManager::GetRunManager()->ReinitializeGeometry(true);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
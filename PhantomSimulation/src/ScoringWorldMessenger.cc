@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/ScoringWorldMessenger.cc
+/// \brief Implementation of the B4::ScoringWorldMessenger class
+
+#include "ScoringWorldMessenger.hh"
+#include "ScoringWorldConstruction.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ScoringWorldMessenger::ScoringWorldMessenger(
+  ScoringWorldConstruction* scoringWorld)
+ : fScoringWorld(scoringWorld)
+{
+  fScoringDirectory = new G4UIdirectory("/phantom/scoring/");
+  fScoringDirectory->SetGuidance(
+    "Scoring volumes of the parallel scoring world: the neutrons crossing\n"
+    "them are counted, whatever the mass volumes they overlap");
+
+  auto createUnitParameter = []() {
+    auto unitPrm = new G4UIparameter("unit", 's', true);
+    unitPrm->SetDefaultUnit("cm");
+    unitPrm->SetParameterCandidates(G4UIcommand::UnitsList("Length").c_str());
+    return unitPrm;
+  };
+
+  fAddBoxCmd = new G4UIcommand("/phantom/scoring/addBox", this);
+  fAddBoxCmd->SetGuidance("Add a box region of interest.");
+  fAddBoxCmd->SetGuidance("It must not overlap any other scoring volume.");
+  fAddBoxCmd->SetParameter(new G4UIparameter("name", 's', false));
+  for ( const auto& prmName : { "x", "y", "z" } ) {
+    fAddBoxCmd->SetParameter(new G4UIparameter(prmName, 'd', false));
+  }
+  for ( const auto& prmName : { "halfX", "halfY", "halfZ" } ) {
+    auto halfSizePrm = new G4UIparameter(prmName, 'd', false);
+    halfSizePrm->SetParameterRange((G4String(prmName) + ">0.").c_str());
+    fAddBoxCmd->SetParameter(halfSizePrm);
+  }
+  fAddBoxCmd->SetParameter(createUnitParameter());
+  fAddBoxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fAddBoxCmd->SetToBeBroadcasted(false);
+
+  fAddPlaneCmd = new G4UIcommand("/phantom/scoring/addPlane", this);
+  fAddPlaneCmd->SetGuidance(
+    "Add a 1 mm thick tally plane spanning the world in x and y at z.");
+  fAddPlaneCmd->SetParameter(new G4UIparameter("name", 's', false));
+  fAddPlaneCmd->SetParameter(new G4UIparameter("z", 'd', false));
+  fAddPlaneCmd->SetParameter(createUnitParameter());
+  fAddPlaneCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fAddPlaneCmd->SetToBeBroadcasted(false);
+
+  fClearCmd = new G4UIcommand("/phantom/scoring/clear", this);
+  fClearCmd->SetGuidance("Remove all scoring volumes.");
+  fClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fClearCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ScoringWorldMessenger::~ScoringWorldMessenger()
+{
+  delete fAddBoxCmd;
+  delete fAddPlaneCmd;
+  delete fClearCmd;
+  delete fScoringDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorldMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if ( command == fAddBoxCmd ) {
+    G4String name, unit;
+    G4double x = 0., y = 0., z = 0., halfX = 0., halfY = 0., halfZ = 0.;
+    std::istringstream is(newValue);
+    is >> name >> x >> y >> z >> halfX >> halfY >> halfZ >> unit;
+    auto scale = G4UIcommand::ValueOf(unit);
+    fScoringWorld->AddBox(name, G4ThreeVector(x, y, z) * scale,
+                          G4ThreeVector(halfX, halfY, halfZ) * scale);
+  }
+
+  if ( command == fAddPlaneCmd ) {
+    G4String name, unit;
+    G4double z = 0.;
+    std::istringstream is(newValue);
+    is >> name >> z >> unit;
+    fScoringWorld->AddPlane(name, z * G4UIcommand::ValueOf(unit));
+  }
+
+  if ( command == fClearCmd ) {
+    fScoringWorld->Clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
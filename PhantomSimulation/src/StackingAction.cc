@@ -0,0 +1,207 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/StackingAction.cc
+/// \brief Implementation of the B4a::StackingAction class
+
+#include "StackingAction.hh"
+#include "RunAction.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4Neutron.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <sstream>
+
+namespace B4a
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingAction::StackingAction(B4::RunAction* runAction)
+ : fRunAction(runAction)
+{
+  // Define commands for this class
+  DefineCommands();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StackingAction::~StackingAction()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4ClassificationOfNewTrack
+StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  // keep primary particles
+  if ( track->GetParentID() == 0 ) return fUrgent;
+
+  auto isNeutron = ( track->GetDefinition() == G4Neutron::Definition() );
+  if ( fPolicy == Policy::kNeutronImaging && ! isNeutron ) {
+    fRunAction->AddKilledTrack();
+    return fKill;
+  }
+
+  // apply the first matching rule
+  for ( const auto& rule : fRules ) {
+    if ( rule.fPDGCode != 0 &&
+         rule.fPDGCode != track->GetDefinition()->GetPDGEncoding() ) continue;
+
+    if ( ! rule.fVolumeName.empty() ) {
+      auto volume = track->GetVolume();
+      if ( ! volume || volume->GetName() != rule.fVolumeName ) continue;
+    }
+
+    if ( rule.fClassification == fKill ) {
+      fRunAction->AddKilledTrack();
+    }
+    else if ( rule.fClassification == fWaiting ) {
+      fRunAction->AddDeferredTrack();
+    }
+    return rule.fClassification;
+  }
+
+  return fUrgent;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::SetPolicy(const G4String& policy)
+{
+  if ( policy == "full" ) {
+    fPolicy = Policy::kFull;
+  }
+  else if ( policy == "neutronImaging" ) {
+    fPolicy = Policy::kNeutronImaging;
+  }
+  else {
+    G4ExceptionDescription msg;
+    msg << "Unknown stacking policy " << policy << "." << G4endl;
+    msg << "The stacking policy was not changed.";
+    G4Exception("StackingAction::SetPolicy()",
+      "MyCode0008", JustWarning, msg);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::AddKillRule(const G4String& rule)
+{
+  AddRule(rule, fKill);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::AddDeferRule(const G4String& rule)
+{
+  AddRule(rule, fWaiting);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::ClearRules()
+{
+  fRules.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::AddRule(const G4String& rule,
+                             G4ClassificationOfNewTrack classification)
+{
+  // rule = "pdgCode [volumeName]"
+  std::istringstream is(rule);
+  Rule newRule;
+  newRule.fClassification = classification;
+  if ( ! ( is >> newRule.fPDGCode ) ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot read the PDG code from \"" << rule << "\"." << G4endl;
+    msg << "The rule was not added.";
+    G4Exception("StackingAction::AddRule()",
+      "MyCode0009", JustWarning, msg);
+    return;
+  }
+  is >> newRule.fVolumeName;
+
+  fRules.push_back(newRule);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StackingAction::DefineCommands()
+{
+  // Define /phantom/stack command directory using generic messenger class
+  fMessenger
+    = new G4GenericMessenger(this,
+                             "/phantom/stack/",
+                             "Secondary particles stacking control");
+
+  // policy command
+  auto& policyCmd
+    = fMessenger->DeclareMethod("policy",
+                                &StackingAction::SetPolicy,
+                                "Select the stacking policy:\n"
+                                " full           - track all secondaries\n"
+                                " neutronImaging - kill all secondaries "
+                                "but neutrons");
+  policyCmd.SetParameterName("policy", false);
+  policyCmd.SetCandidates("full neutronImaging");
+  policyCmd.SetDefaultValue("full");
+
+  // kill command
+  auto& killCmd
+    = fMessenger->DeclareMethod("kill",
+                                &StackingAction::AddKillRule,
+                                "Kill the secondaries with the given PDG code "
+                                "(0 = any),\n"
+                                "optionally only when created in the given "
+                                "physical volume.");
+  killCmd.SetParameterName("rule", false);
+
+  // defer command
+  auto& deferCmd
+    = fMessenger->DeclareMethod("defer",
+                                &StackingAction::AddDeferRule,
+                                "Defer to the waiting stack the secondaries "
+                                "with the given PDG code (0 = any),\n"
+                                "optionally only when created in the given "
+                                "physical volume.");
+  deferCmd.SetParameterName("rule", false);
+
+  // clearRules command
+  fMessenger->DeclareMethod("clearRules",
+                            &StackingAction::ClearRules,
+                            "Remove all kill and defer rules.");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
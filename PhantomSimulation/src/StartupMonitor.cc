@@ -0,0 +1,123 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/StartupMonitor.cc
+/// \brief Implementation of the B4::StartupMonitor class
+
+#include "StartupMonitor.hh"
+
+#include <fstream>
+#include <iomanip>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+StartupMonitor* StartupMonitor::Instance()
+{
+  static StartupMonitor instance;
+  return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StartupMonitor::Start(const G4String& physicsListName)
+{
+  fPhysicsListName = physicsListName;
+  fStarted = true;
+  fDone = false;
+  fTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StartupMonitor::BeginOfRun()
+{
+  if ( ! fStarted || fDone ) return;
+
+  fTimer.Stop();
+  fStartupTime = fTimer.GetRealElapsed();
+  fStartupMemory = GetResidentMemory();
+  fDone = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void StartupMonitor::Print() const
+{
+  if ( ! fDone ) return;
+
+  G4cout
+    << " Physics list " << fPhysicsListName << ": startup "
+    << std::setprecision(3) << fStartupTime << " s, memory at startup "
+    << fStartupMemory << " MB, peak " << GetPeakResidentMemory() << " MB"
+    << std::setprecision(6) << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double StartupMonitor::GetResidentMemory()
+{
+#if defined(__linux__)
+  // the second field of statm is the resident set size in pages
+  std::ifstream statm("/proc/self/statm");
+  long size = 0;
+  long resident = 0;
+  if ( statm >> size >> resident ) {
+    return static_cast<G4double>(resident) * sysconf(_SC_PAGESIZE) / (1024. * 1024.);
+  }
+#endif
+  return 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double StartupMonitor::GetPeakResidentMemory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if ( getrusage(RUSAGE_SELF, &usage) == 0 ) {
+#if defined(__APPLE__)
+    // in bytes on macOS
+    return static_cast<G4double>(usage.ru_maxrss) / (1024. * 1024.);
+#else
+    // in kilobytes on Linux
+    return static_cast<G4double>(usage.ru_maxrss) / 1024.;
+#endif
+  }
+#endif
+  return 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,137 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/StlMesh.cc
+/// \brief Implementation of the B4::StlMesh class
+
+#include "StlMesh.hh"
+
+#include "G4Timer.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace B4
+{
+
+namespace
+{
+
+// binary STL layout
+constexpr std::size_t kStlHeaderSize = 80;
+constexpr std::size_t kStlFacetSize = 50;
+
+float ReadFloat(const unsigned char* data)
+{
+  // little endian
+  std::uint32_t bits = std::uint32_t(data[0])
+                       | std::uint32_t(data[1]) << 8
+                       | std::uint32_t(data[2]) << 16
+                       | std::uint32_t(data[3]) << 24;
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool StlMesh::Load(const G4String& fileName, G4double unit)
+{
+  G4Timer timer;
+  timer.Start();
+
+  G4String error;
+  std::vector<unsigned char> buffer;
+
+  // Read the whole file at once
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if ( ! file ) {
+    error = "cannot open the file";
+  }
+  else {
+    buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    if ( ! file.read(reinterpret_cast<char*>(buffer.data()), buffer.size()) ) {
+      error = "cannot read the file";
+    }
+  }
+
+  // Check the size: an ASCII STL file does not match it
+  std::size_t nofFacets = 0;
+  if ( error.empty() ) {
+    if ( buffer.size() >= kStlHeaderSize + 4 ) {
+      const auto* count = buffer.data() + kStlHeaderSize;
+      nofFacets = std::size_t(count[0]) | std::size_t(count[1]) << 8
+                  | std::size_t(count[2]) << 16 | std::size_t(count[3]) << 24;
+    }
+    if ( nofFacets == 0 ||
+         buffer.size() != kStlHeaderSize + 4 + nofFacets * kStlFacetSize ) {
+      error = "this is not a binary STL file, or it is empty or truncated";
+    }
+  }
+
+  if ( ! error.empty() ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot read STL file " << fileName << ": " << error << ".";
+    G4Exception("StlMesh::Load()",
+      "MyCode0017", JustWarning, msg);
+    return false;
+  }
+
+  // Read the vertices, skip the normals and the attributes
+  fVertices.resize(3 * nofFacets);
+  const auto* data = buffer.data() + kStlHeaderSize + 4;
+  for ( std::size_t i = 0; i < nofFacets; ++i, data += kStlFacetSize ) {
+    for ( G4int v = 0; v < 3; ++v ) {
+      const auto* vertex = data + 12 * (v + 1);
+      fVertices[3 * i + v].set(ReadFloat(vertex) * unit,
+                               ReadFloat(vertex + 4) * unit,
+                               ReadFloat(vertex + 8) * unit);
+    }
+  }
+
+  fMin = fMax = fVertices[0];
+  for ( const auto& vertex : fVertices ) {
+    fMin.set(std::min(fMin.x(), vertex.x()), std::min(fMin.y(), vertex.y()),
+             std::min(fMin.z(), vertex.z()));
+    fMax.set(std::max(fMax.x(), vertex.x()), std::max(fMax.y(), vertex.y()),
+             std::max(fMax.z(), vertex.z()));
+  }
+
+  fFileName = fileName;
+  timer.Stop();
+  fReadTime = timer.GetRealElapsed();
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
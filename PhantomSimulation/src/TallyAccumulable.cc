@@ -0,0 +1,78 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/TallyAccumulable.cc
+/// \brief Implementation of the B4::TallyAccumulable class
+
+#include "TallyAccumulable.hh"
+
+#include "G4ios.hh"
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TallyAccumulable::TallyAccumulable(const G4String& name)
+ : G4VAccumulable(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TallyAccumulable::Merge(const G4VAccumulable& other)
+{
+  for ( const auto& [name, tally]
+          : static_cast<const TallyAccumulable&>(other).fTallies ) {
+    auto& thisTally = fTallies[name];
+    thisTally.fCount += tally.fCount;
+    thisTally.fWeight += tally.fWeight;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TallyAccumulable::Reset()
+{
+  fTallies.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TallyAccumulable::PrintTallies(const G4String& title) const
+{
+  if ( fTallies.empty() ) return;
+
+  G4cout << G4endl << " " << title << G4endl;
+  for ( const auto& [name, tally] : fTallies ) {
+    G4cout
+      << "   " << name << ": " << tally.fCount
+      << " entries, sum of weights " << tally.fWeight << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,87 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/TrackingAction.cc
+/// \brief Implementation of the B4a::TrackingAction class
+
+#include "TrackingAction.hh"
+#include "RunAction.hh"
+#include "TrackInformation.hh"
+
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4Track.hh"
+#include "G4TrackVector.hh"
+#include "G4TrackingManager.hh"
+
+namespace B4a
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+TrackingAction::TrackingAction(B4::RunAction* runAction)
+ : fRunAction(runAction)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  // The primaries (one per vertex) get the track IDs 1, 2, ...
+  // in the order of the vertices; with a single vertex all the tracks
+  // belong to slot 0 and are not tagged
+  if ( track->GetParentID() != 0 || track->GetUserInformation() ) return;
+
+  auto event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if ( event->GetNumberOfPrimaryVertex() < 2 ) return;
+
+  track->SetUserInformation(new TrackInformation(track->GetTrackID() - 1));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void TrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  fRunAction->AddSteps(track->GetCurrentStepNumber());
+
+  auto info = static_cast<TrackInformation*>(track->GetUserInformation());
+  if ( ! info ) return;
+
+  // The secondaries inherit the primary slot
+  auto secondaries = fpTrackingManager->GimmeSecondaries();
+  if ( ! secondaries ) return;
+
+  for ( auto secondary : *secondaries ) {
+    if ( ! secondary->GetUserInformation() ) {
+      secondary->SetUserInformation(
+        new TrackInformation(info->GetPrimarySlot()));
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}
@@ -0,0 +1,213 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B4/B4a/src/VoxelPhantom.cc
+/// \brief Implementation of the B4::VoxelPhantom class
+
+#include "VoxelPhantom.hh"
+
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
+
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace B4
+{
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool VoxelPhantom::Load(const G4String& headerFileName)
+{
+  G4String error;
+  G4int nofVoxels[3] = { 0, 0, 0 };
+  G4ThreeVector voxelSize;
+  G4int bytesPerVoxel = 1;
+  std::vector<G4String> materialNames;
+  G4String dataFileName;
+
+  std::ifstream file(headerFileName);
+  if ( ! file ) error = "cannot open the file";
+
+  std::string line;
+  while ( error.empty() && std::getline(file, line) ) {
+    auto first = line.find_first_not_of(" \t\r");
+    if ( first == std::string::npos || line[first] == '#' ) continue;
+
+    std::istringstream is(line);
+    G4String keyword;
+    is >> keyword;
+    if ( keyword == "dimensions" ) {
+      is >> nofVoxels[0] >> nofVoxels[1] >> nofVoxels[2];
+    }
+    else if ( keyword == "voxelSize" ) {
+      G4double dx = 0., dy = 0., dz = 0.;
+      G4String unit;
+      if ( is >> dx >> dy >> dz >> unit ) {
+        voxelSize = G4ThreeVector(dx, dy, dz) * G4UIcommand::ValueOf(unit);
+      }
+    }
+    else if ( keyword == "type" ) {
+      G4String type;
+      is >> type;
+      if ( type == "uint8" ) bytesPerVoxel = 1;
+      else if ( type == "uint16" ) bytesPerVoxel = 2;
+      else error = "unknown data type " + type;
+    }
+    else if ( keyword == "material" ) {
+      std::size_t index = 0;
+      G4String name;
+      if ( is >> index >> name ) {
+        if ( index >= kMaxNofMaterials ) {
+          error = "material index " + std::to_string(index) + " out of range";
+        }
+        else {
+          if ( materialNames.size() <= index ) materialNames.resize(index + 1);
+          materialNames[index] = name;
+        }
+      }
+    }
+    else if ( keyword == "data" ) {
+      is >> dataFileName;
+    }
+    else {
+      error = "unknown keyword " + keyword;
+    }
+
+    if ( error.empty() && is.fail() ) error = "cannot read line \"" + line + "\"";
+  }
+
+  // Check the header
+  if ( error.empty() ) {
+    if ( nofVoxels[0] <= 0 || nofVoxels[1] <= 0 || nofVoxels[2] <= 0 ) {
+      error = "missing or invalid dimensions";
+    }
+    else if ( voxelSize.x() <= 0. || voxelSize.y() <= 0. || voxelSize.z() <= 0. ) {
+      error = "missing or invalid voxel size";
+    }
+    else if ( materialNames.empty() ) {
+      error = "no material";
+    }
+    else if ( dataFileName.empty() ) {
+      error = "no data file";
+    }
+    for ( std::size_t i = 0; error.empty() && i < materialNames.size(); ++i ) {
+      if ( materialNames[i].empty() ) {
+        error = "no material for index " + std::to_string(i);
+      }
+    }
+  }
+
+  // The data file is relative to the header directory
+  if ( error.empty() && dataFileName[0] != '/' ) {
+    auto separator = headerFileName.rfind('/');
+    if ( separator != std::string::npos ) {
+      dataFileName = headerFileName.substr(0, separator + 1) + dataFileName;
+    }
+  }
+
+  // The phantom is read in local variables: a failed load leaves the
+  // phantom loaded before unchanged
+  std::vector<std::size_t> materialIndices;
+  if ( error.empty() ) {
+    auto nofAllVoxels = static_cast<std::size_t>(nofVoxels[0])
+                        * static_cast<std::size_t>(nofVoxels[1])
+                        * static_cast<std::size_t>(nofVoxels[2]);
+    ReadData(dataFileName, nofAllVoxels, bytesPerVoxel, materialNames.size(),
+             materialIndices, error);
+  }
+
+  if ( ! error.empty() ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot read voxel phantom " << headerFileName << ": "
+        << error << ".";
+    G4Exception("VoxelPhantom::Load()",
+      "MyCode0016", JustWarning, msg);
+    return false;
+  }
+
+  fFileName = headerFileName;
+  for ( G4int i = 0; i < 3; ++i ) fNofVoxels[i] = nofVoxels[i];
+  fVoxelHalfSize = 0.5 * voxelSize;
+  fMaterialNames = std::move(materialNames);
+  fMaterialIndices = std::move(materialIndices);
+
+  G4cout
+    << "--> Voxel phantom " << headerFileName << ": "
+    << fNofVoxels[0] << " x " << fNofVoxels[1] << " x " << fNofVoxels[2]
+    << " voxels of " << G4BestUnit(voxelSize, "Length") << ", "
+    << fMaterialNames.size() << " material(s)" << G4endl;
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool VoxelPhantom::ReadData(const G4String& fileName,
+                              std::size_t nofVoxels, G4int bytesPerVoxel,
+                              std::size_t nofMaterials,
+                              std::vector<std::size_t>& materialIndices,
+                              G4String& error)
+{
+  // Read the whole file at once
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if ( ! file ) {
+    error = "cannot open the data file " + fileName;
+    return false;
+  }
+  auto size = static_cast<std::size_t>(file.tellg());
+  if ( size != nofVoxels * bytesPerVoxel ) {
+    error = "the data file " + fileName + " has " + std::to_string(size)
+            + " bytes instead of " + std::to_string(nofVoxels * bytesPerVoxel);
+    return false;
+  }
+  std::vector<unsigned char> buffer(size);
+  file.seekg(0);
+  if ( ! file.read(reinterpret_cast<char*>(buffer.data()), size) ) {
+    error = "cannot read the data file " + fileName;
+    return false;
+  }
+
+  // Convert to the material indices (little endian)
+  materialIndices.resize(nofVoxels);
+  for ( std::size_t i = 0; i < nofVoxels; ++i ) {
+    std::size_t index = buffer[i * bytesPerVoxel];
+    if ( bytesPerVoxel == 2 ) index |= std::size_t(buffer[2 * i + 1]) << 8;
+    if ( index >= nofMaterials ) {
+      error = "voxel " + std::to_string(i) + " has the undefined material index "
+              + std::to_string(index);
+      return false;
+    }
+    materialIndices[i] = index;
+  }
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+}